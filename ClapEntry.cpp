@@ -0,0 +1,490 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - CLAP Entry Point
+  JUCE 8.0.11
+
+  Native CLAP wrapper around DdxReverbAudioProcessor, built into a .clap
+  alongside the JUCE modules and the plugin sources (CLAP SDK headers on
+  the include path). It exposes what CLAP can do better than a realtime-only
+  VST3:
+    - thread-pool: the processor's independent network work (low band vs
+      main late stage, crossfading engines, surround lane networks) runs
+      on the host's own workers, in realtime as well as offline
+    - tail: the decay-dependent tail length from getTailLengthSeconds()
+    - process status: CONTINUE_IF_NOT_QUIET while ringing, SLEEP once the
+      tail tracker has put the network to sleep, so the host stops calling
+  Main stereo in/out only; the aux sends and quad outputs stay VST3-only.
+*/
+
+#include <clap/clap.h>
+#include "PluginProcessor.h"
+
+namespace
+{
+    //==============================================================================
+    // RenderTaskPool backed by the host's clap_host_thread_pool. The host may
+    // only be asked from process() on the audio thread, so forks from anywhere
+    // else (the pipeline worker, a task that forks again) run in line.
+    //==============================================================================
+    class ClapTaskPool : public RenderTaskPool
+    {
+    public:
+        ClapTaskPool(const clap_host_t* h, const clap_host_thread_pool_t* pool)
+            : host(h), hostPool(pool)
+        {
+        }
+
+        bool isAvailable() const noexcept { return hostPool != nullptr && hostPool->request_exec != nullptr; }
+
+        void beginProcess() noexcept { processThread = juce::Thread::getCurrentThreadId(); }
+        void endProcess() noexcept { processThread = nullptr; }
+
+        void forEach(int numTasks, const Task& task) override
+        {
+            const bool canAskHost = numTasks > 1
+                && juce::Thread::getCurrentThreadId() == processThread
+                && currentTask.load() == nullptr;
+
+            if (canAskHost)
+            {
+                currentTask = &task;
+                const bool ranOnHost = hostPool->request_exec(host, static_cast<uint32_t>(numTasks));
+                currentTask = nullptr;
+
+                if (ranOnHost)
+                    return;
+            }
+
+            for (int i = 0; i < numTasks; ++i)
+                task(i);
+        }
+
+        // clap_plugin_thread_pool::exec, on a host worker - with the same
+        // denormal flushing as the process call, so a task rounds the same
+        // wherever it runs
+        void exec(uint32_t taskIndex) noexcept
+        {
+            if (auto* task = currentTask.load())
+            {
+                juce::ScopedNoDenormals noDenormals;
+                (*task)(static_cast<int>(taskIndex));
+            }
+        }
+
+    private:
+        const clap_host_t* host;
+        const clap_host_thread_pool_t* hostPool;
+        juce::Thread::ThreadID processThread = nullptr;
+        std::atomic<const Task*> currentTask { nullptr };
+    };
+
+    //==============================================================================
+    // One plugin instance
+    //==============================================================================
+    struct ClapInstance
+    {
+        clap_plugin_t plugin {};
+        const clap_host_t* host = nullptr;
+        std::unique_ptr<DdxReverbAudioProcessor> processor;
+        std::unique_ptr<ClapTaskPool> taskPool;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        double sampleRate = 48000.0;
+    };
+
+    ClapInstance& getInstance(const clap_plugin_t* plugin) noexcept
+    {
+        return *static_cast<ClapInstance*>(plugin->plugin_data);
+    }
+
+    juce::RangedAudioParameter* getParameter(ClapInstance& instance, clap_id paramId) noexcept
+    {
+        const auto& params = instance.processor->getParameters();
+
+        if (!juce::isPositiveAndBelow(static_cast<int>(paramId), params.size()))
+            return nullptr;
+
+        return dynamic_cast<juce::RangedAudioParameter*>(params[static_cast<int>(paramId)]);
+    }
+
+    // Parameter values cross the CLAP boundary normalised to 0..1, ids are
+    // the processor's parameter indices
+    void applyParameterEvents(ClapInstance& instance, const clap_input_events_t* events) noexcept
+    {
+        if (events == nullptr)
+            return;
+
+        const uint32_t numEvents = events->size(events);
+
+        for (uint32_t i = 0; i < numEvents; ++i)
+        {
+            const auto* header = events->get(events, i);
+
+            if (header->space_id != CLAP_CORE_EVENT_SPACE_ID || header->type != CLAP_EVENT_PARAM_VALUE)
+                continue;
+
+            const auto* event = reinterpret_cast<const clap_event_param_value_t*>(header);
+
+            if (auto* param = getParameter(instance, event->param_id))
+                param->setValueNotifyingHost(static_cast<float>(event->value));
+        }
+    }
+
+    //==============================================================================
+    // Extensions
+    //==============================================================================
+    uint32_t audioPortsCount(const clap_plugin_t*, bool) noexcept
+    {
+        return 1;
+    }
+
+    bool audioPortsGet(const clap_plugin_t*, uint32_t index, bool isInput, clap_audio_port_info_t* info) noexcept
+    {
+        if (index != 0)
+            return false;
+
+        info->id = 0;
+        std::snprintf(info->name, sizeof(info->name), "%s", isInput ? "Input" : "Output");
+        info->flags = CLAP_AUDIO_PORT_IS_MAIN;
+        info->channel_count = 2;
+        info->port_type = CLAP_PORT_STEREO;
+        info->in_place_pair = 0;
+        return true;
+    }
+
+    const clap_plugin_audio_ports_t audioPortsExtension { audioPortsCount, audioPortsGet };
+
+    uint32_t paramsCount(const clap_plugin_t* plugin) noexcept
+    {
+        return static_cast<uint32_t>(getInstance(plugin).processor->getParameters().size());
+    }
+
+    bool paramsGetInfo(const clap_plugin_t* plugin, uint32_t index, clap_param_info_t* info) noexcept
+    {
+        auto* param = getParameter(getInstance(plugin), index);
+
+        if (param == nullptr)
+            return false;
+
+        *info = {};
+        info->id = index;
+        info->flags = CLAP_PARAM_IS_AUTOMATABLE;
+
+        if (param->isDiscrete())
+            info->flags |= CLAP_PARAM_IS_STEPPED;
+
+        std::snprintf(info->name, sizeof(info->name), "%s", param->getName(CLAP_NAME_SIZE).toRawUTF8());
+        info->min_value = 0.0;
+        info->max_value = 1.0;
+        info->default_value = param->getDefaultValue();
+        return true;
+    }
+
+    bool paramsGetValue(const clap_plugin_t* plugin, clap_id paramId, double* value) noexcept
+    {
+        auto* param = getParameter(getInstance(plugin), paramId);
+
+        if (param == nullptr)
+            return false;
+
+        *value = param->getValue();
+        return true;
+    }
+
+    bool paramsValueToText(const clap_plugin_t* plugin, clap_id paramId, double value, char* display, uint32_t size) noexcept
+    {
+        auto* param = getParameter(getInstance(plugin), paramId);
+
+        if (param == nullptr || size == 0)
+            return false;
+
+        auto text = param->getText(static_cast<float>(value), static_cast<int>(size) - 1);
+        const auto label = param->getLabel();
+
+        if (label.isNotEmpty())
+            text << " " << label;
+
+        std::snprintf(display, size, "%s", text.toRawUTF8());
+        return true;
+    }
+
+    bool paramsTextToValue(const clap_plugin_t* plugin, clap_id paramId, const char* display, double* value) noexcept
+    {
+        auto* param = getParameter(getInstance(plugin), paramId);
+
+        if (param == nullptr)
+            return false;
+
+        *value = param->getValueForText(juce::String::fromUTF8(display));
+        return true;
+    }
+
+    void paramsFlush(const clap_plugin_t* plugin, const clap_input_events_t* in, const clap_output_events_t*) noexcept
+    {
+        applyParameterEvents(getInstance(plugin), in);
+    }
+
+    const clap_plugin_params_t paramsExtension { paramsCount, paramsGetInfo, paramsGetValue,
+                                                 paramsValueToText, paramsTextToValue, paramsFlush };
+
+    bool stateSave(const clap_plugin_t* plugin, const clap_ostream_t* stream) noexcept
+    {
+        juce::MemoryBlock state;
+        getInstance(plugin).processor->getStateInformation(state);
+
+        auto* data = static_cast<const char*>(state.getData());
+        size_t written = 0;
+
+        while (written < state.getSize())
+        {
+            const auto result = stream->write(stream, data + written, state.getSize() - written);
+
+            if (result <= 0)
+                return false;
+
+            written += static_cast<size_t>(result);
+        }
+
+        return true;
+    }
+
+    bool stateLoad(const clap_plugin_t* plugin, const clap_istream_t* stream) noexcept
+    {
+        juce::MemoryBlock state;
+        char chunk[4096];
+
+        for (;;)
+        {
+            const auto result = stream->read(stream, chunk, sizeof(chunk));
+
+            if (result < 0)
+                return false;
+
+            if (result == 0)
+                break;
+
+            state.append(chunk, static_cast<size_t>(result));
+        }
+
+        getInstance(plugin).processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        return true;
+    }
+
+    const clap_plugin_state_t stateExtension { stateSave, stateLoad };
+
+    uint32_t latencyGet(const clap_plugin_t* plugin) noexcept
+    {
+        return static_cast<uint32_t>(juce::jmax(0, getInstance(plugin).processor->getLatencySamples()));
+    }
+
+    const clap_plugin_latency_t latencyExtension { latencyGet };
+
+    // Follows the decay and pre-delay controls
+    uint32_t tailGet(const clap_plugin_t* plugin) noexcept
+    {
+        auto& instance = getInstance(plugin);
+        const double tailSamples = instance.processor->getTailLengthSeconds() * instance.sampleRate;
+
+        return static_cast<uint32_t>(juce::jlimit(0.0, static_cast<double>(INT32_MAX), std::ceil(tailSamples)));
+    }
+
+    const clap_plugin_tail_t tailExtension { tailGet };
+
+    void threadPoolExec(const clap_plugin_t* plugin, uint32_t taskIndex) noexcept
+    {
+        getInstance(plugin).taskPool->exec(taskIndex);
+    }
+
+    const clap_plugin_thread_pool_t threadPoolExtension { threadPoolExec };
+
+    // Offline renders get the plugin's own bounce pool when the host has none:
+    // setNonRealtime creates it right here, on the main thread
+    bool renderHasHardRealtimeRequirement(const clap_plugin_t*) noexcept
+    {
+        return false;
+    }
+
+    bool renderSet(const clap_plugin_t* plugin, clap_plugin_render_mode mode) noexcept
+    {
+        getInstance(plugin).processor->setNonRealtime(mode == CLAP_RENDER_OFFLINE);
+        return true;
+    }
+
+    const clap_plugin_render_t renderExtension { renderHasHardRealtimeRequirement, renderSet };
+
+    //==============================================================================
+    // Plugin
+    //==============================================================================
+    const char* const pluginFeatures[] = { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, CLAP_PLUGIN_FEATURE_REVERB,
+                                           CLAP_PLUGIN_FEATURE_STEREO, nullptr };
+
+    const clap_plugin_descriptor_t pluginDescriptor
+    {
+        CLAP_VERSION_INIT,
+        "com.ddx3216.cathedral-reverb",
+        "DDX3216 Cathedral Reverb",
+        "DDX3216",
+        "", "", "",
+        "1.0.0",
+        "SHARC-style comb/all-pass cathedral reverb",
+        pluginFeatures
+    };
+
+    bool pluginInit(const clap_plugin_t* plugin) noexcept
+    {
+        auto& instance = getInstance(plugin);
+        instance.processor.reset(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+
+        auto* hostPool = static_cast<const clap_host_thread_pool_t*>(
+            instance.host->get_extension(instance.host, CLAP_EXT_THREAD_POOL));
+
+        instance.taskPool = std::make_unique<ClapTaskPool>(instance.host, hostPool);
+
+        if (instance.taskPool->isAvailable())
+            instance.processor->setHostTaskPool(instance.taskPool.get());
+
+        return true;
+    }
+
+    void pluginDestroy(const clap_plugin_t* plugin) noexcept
+    {
+        auto* instance = static_cast<ClapInstance*>(plugin->plugin_data);
+
+        if (instance->processor != nullptr)
+            instance->processor->setHostTaskPool(nullptr);
+
+        delete instance;
+    }
+
+    bool pluginActivate(const clap_plugin_t* plugin, double sampleRate, uint32_t, uint32_t maxFrames) noexcept
+    {
+        auto& instance = getInstance(plugin);
+        const int blockSize = static_cast<int>(maxFrames);
+
+        instance.sampleRate = sampleRate;
+        instance.buffer.setSize(2, blockSize);
+        instance.processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        instance.processor->prepareToPlay(sampleRate, blockSize);
+        return true;
+    }
+
+    void pluginDeactivate(const clap_plugin_t* plugin) noexcept
+    {
+        getInstance(plugin).processor->releaseResources();
+    }
+
+    bool pluginStartProcessing(const clap_plugin_t*) noexcept { return true; }
+    void pluginStopProcessing(const clap_plugin_t*) noexcept {}
+
+    void pluginReset(const clap_plugin_t* plugin) noexcept
+    {
+        auto& instance = getInstance(plugin);
+        instance.processor->reset();
+    }
+
+    clap_process_status pluginProcess(const clap_plugin_t* plugin, const clap_process_t* process) noexcept
+    {
+        auto& instance = getInstance(plugin);
+        const int numSamples = static_cast<int>(process->frames_count);
+
+        if (numSamples > instance.buffer.getNumSamples()
+            || process->audio_inputs_count < 1 || process->audio_outputs_count < 1)
+            return CLAP_PROCESS_ERROR;
+
+        applyParameterEvents(instance, process->in_events);
+
+        // Hosts may pass the same pointers in and out, so go through our buffer
+        const auto& input = process->audio_inputs[0];
+        const auto& output = process->audio_outputs[0];
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const auto source = juce::jmin(static_cast<uint32_t>(channel), input.channel_count - 1);
+            instance.buffer.copyFrom(channel, 0, input.data32[source], numSamples);
+        }
+
+        juce::AudioBuffer<float> block(instance.buffer.getArrayOfWritePointers(), 2, numSamples);
+
+        instance.taskPool->beginProcess();
+        instance.processor->processBlock(block, instance.midi);
+        instance.taskPool->endProcess();
+
+        for (uint32_t channel = 0; channel < output.channel_count; ++channel)
+            juce::FloatVectorOperations::copy(output.data32[channel], block.getReadPointer(juce::jmin(static_cast<int>(channel), 1)), numSamples);
+
+        // The tail tracker has confirmed the delay memory is silent: the host
+        // can stop calling until the input has something in it again
+        if (instance.processor->isNetworkAsleep())
+            return CLAP_PROCESS_SLEEP;
+
+        return CLAP_PROCESS_CONTINUE_IF_NOT_QUIET;
+    }
+
+    const void* pluginGetExtension(const clap_plugin_t* plugin, const char* id) noexcept
+    {
+        if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) return &audioPortsExtension;
+        if (std::strcmp(id, CLAP_EXT_PARAMS) == 0)      return &paramsExtension;
+        if (std::strcmp(id, CLAP_EXT_STATE) == 0)       return &stateExtension;
+        if (std::strcmp(id, CLAP_EXT_LATENCY) == 0)     return &latencyExtension;
+        if (std::strcmp(id, CLAP_EXT_TAIL) == 0)        return &tailExtension;
+        if (std::strcmp(id, CLAP_EXT_RENDER) == 0)      return &renderExtension;
+
+        if (std::strcmp(id, CLAP_EXT_THREAD_POOL) == 0 && getInstance(plugin).taskPool->isAvailable())
+            return &threadPoolExtension;
+
+        return nullptr;
+    }
+
+    void pluginOnMainThread(const clap_plugin_t*) noexcept {}
+
+    //==============================================================================
+    // Factory and entry
+    //==============================================================================
+    uint32_t factoryGetPluginCount(const clap_plugin_factory_t*) noexcept
+    {
+        return 1;
+    }
+
+    const clap_plugin_descriptor_t* factoryGetPluginDescriptor(const clap_plugin_factory_t*, uint32_t index) noexcept
+    {
+        return index == 0 ? &pluginDescriptor : nullptr;
+    }
+
+    const clap_plugin_t* factoryCreatePlugin(const clap_plugin_factory_t*, const clap_host_t* host, const char* pluginId) noexcept
+    {
+        if (!clap_version_is_compatible(host->clap_version) || std::strcmp(pluginId, pluginDescriptor.id) != 0)
+            return nullptr;
+
+        auto* instance = new ClapInstance();
+        instance->host = host;
+
+        instance->plugin = { &pluginDescriptor, instance,
+                             pluginInit, pluginDestroy, pluginActivate, pluginDeactivate,
+                             pluginStartProcessing, pluginStopProcessing, pluginReset,
+                             pluginProcess, pluginGetExtension, pluginOnMainThread };
+
+        return &instance->plugin;
+    }
+
+    const clap_plugin_factory_t pluginFactory { factoryGetPluginCount, factoryGetPluginDescriptor, factoryCreatePlugin };
+
+    // JUCE's message manager has to exist before any processor does
+    std::unique_ptr<juce::ScopedJuceInitialiser_GUI> juceInitialiser;
+
+    bool entryInit(const char*)
+    {
+        juceInitialiser = std::make_unique<juce::ScopedJuceInitialiser_GUI>();
+        return true;
+    }
+
+    void entryDeinit()
+    {
+        juceInitialiser.reset();
+    }
+
+    const void* entryGetFactory(const char* factoryId)
+    {
+        return std::strcmp(factoryId, CLAP_PLUGIN_FACTORY_ID) == 0 ? &pluginFactory : nullptr;
+    }
+}
+
+extern "C" CLAP_EXPORT const clap_plugin_entry_t clap_entry { CLAP_VERSION_INIT, entryInit, entryDeinit, entryGetFactory };
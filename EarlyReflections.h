@@ -0,0 +1,160 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Early Reflections
+  JUCE 8.0.11
+
+  Sparse multi-tap delay between the pre-delay and the late stage, for the
+  distinct first reflections of the DDX3216 hall and cathedral programs.
+  It owns no delay memory: the taps read the engine's pre-delay line, each
+  tap sitting a fixed distance behind the pre-delay's own read point.
+
+  The engine writes a whole block into the pre-delay line before reading
+  it, so every tap is one contiguous span of the buffer (two at the wrap).
+  Taps are summed a span at a time with a vector multiply-add, sorted by
+  delay so consecutive taps walk forward through the same cache lines.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Tap patterns - appended only, the "early" parameter stores the index + 1
+//==============================================================================
+enum class EarlyPattern
+{
+    off,
+    cathedral, // 32 taps over ~110ms, late first reflection
+    hall,      // 24 taps over ~75ms
+    room       // 16 taps over ~35ms, starting almost at once
+};
+
+constexpr int numEarlyPatterns = 4;
+
+//==============================================================================
+// Early Reflections - taps read straight from the pre-delay line
+//==============================================================================
+class EarlyReflections
+{
+public:
+    static constexpr int maxTaps = 32;
+
+    // Latest tap of any pattern; the pre-delay line is sized with this much
+    // room behind its longest pre-delay
+    static constexpr double maxSpanSeconds = 0.12;
+
+    struct PatternSpec
+    {
+        int numTaps;
+        float firstMs;  // start of the pattern, after the pre-delay
+        float spanMs;   // first to last tap
+        float level;    // RMS sum of the tap gains
+        int seed;
+    };
+
+    static constexpr PatternSpec patternSpecs[numEarlyPatterns] =
+    {
+        {  0,  0.0f,  0.0f, 0.0f,  0 },
+        { 32, 17.0f, 95.0f, 0.5f,  0x45524331 },
+        { 24, 11.0f, 64.0f, 0.5f,  0x45524332 },
+        { 16,  3.0f, 31.0f, 0.45f, 0x45524333 }
+    };
+
+    static int getMaxDelaySamples(double sampleRate) noexcept
+    {
+        return static_cast<int>(std::ceil(maxSpanSeconds * sampleRate));
+    }
+
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        updateTapDelays();
+    }
+
+    void setPattern(EarlyPattern newPattern) noexcept
+    {
+        if (newPattern == pattern)
+            return;
+
+        pattern = newPattern;
+        updateTaps();
+    }
+
+    EarlyPattern getPattern() const noexcept { return pattern; }
+    int getNumTaps() const noexcept { return numTaps; }
+    bool isActive() const noexcept { return numTaps > 0; }
+
+    // Sums the taps for the block that was just written to 'ring' starting at
+    // blockStart. baseDelay is the pre-delay; baseDelay + the longest tap +
+    // numSamples must fit in the ring, or the block overwrites what it reads.
+    void process(const float* ring, int ringSize, int blockStart, int baseDelay,
+                 float* output, int numSamples) const noexcept
+    {
+        juce::FloatVectorOperations::clear(output, numSamples);
+
+        for (int k = 0; k < numTaps; ++k)
+        {
+            int start = blockStart - baseDelay - tapDelays[static_cast<size_t>(k)];
+            if (start < 0)
+                start += ringSize;
+
+            const float gain = tapGains[static_cast<size_t>(k)];
+            const int first = juce::jmin(numSamples, ringSize - start);
+
+            juce::FloatVectorOperations::addWithMultiply(output, ring + start, gain, first);
+
+            if (first < numSamples)
+                juce::FloatVectorOperations::addWithMultiply(output + first, ring, gain, numSamples - first);
+        }
+    }
+
+private:
+    // Fixed seed per pattern, so every instance has the same reflections.
+    // One tap per cell at a random offset; cells follow a square-root curve,
+    // so the reflections thicken towards the end as they do in a real room.
+    void updateTaps() noexcept
+    {
+        const auto& spec = patternSpecs[static_cast<int>(pattern)];
+        numTaps = spec.numTaps;
+
+        if (numTaps == 0)
+            return;
+
+        juce::Random random(spec.seed);
+        float sumOfSquares = 0.0f;
+
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const float position = std::sqrt((static_cast<float>(k) + 0.2f + 0.6f * random.nextFloat()) / static_cast<float>(numTaps));
+            const float gain = std::exp(-2.0f * position * position); // ~17dB down by the last tap
+
+            tapMs[static_cast<size_t>(k)] = spec.firstMs + spec.spanMs * position;
+            tapGains[static_cast<size_t>(k)] = random.nextBool() ? gain : -gain;
+            sumOfSquares += gain * gain;
+        }
+
+        const float scale = spec.level / std::sqrt(sumOfSquares);
+
+        for (int k = 0; k < numTaps; ++k)
+            tapGains[static_cast<size_t>(k)] *= scale;
+
+        updateTapDelays();
+    }
+
+    void updateTapDelays() noexcept
+    {
+        const int maxDelay = getMaxDelaySamples(sampleRate);
+
+        for (int k = 0; k < numTaps; ++k)
+            tapDelays[static_cast<size_t>(k)] = juce::jlimit(0, maxDelay,
+                juce::roundToInt(tapMs[static_cast<size_t>(k)] * sampleRate / 1000.0));
+    }
+
+    double sampleRate = 48000.0;
+    EarlyPattern pattern = EarlyPattern::off;
+    int numTaps = 0;
+
+    std::array<float, maxTaps> tapMs {};
+    std::array<int, maxTaps> tapDelays {};
+    std::array<float, maxTaps> tapGains {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EarlyReflections)
+};
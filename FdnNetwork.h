@@ -0,0 +1,237 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Feedback Delay Network
+  JUCE 8.0.11
+
+  Drop-in replacement for the four parallel combs: 4 or 8 delay lines whose
+  damped outputs are mixed back through an orthogonal matrix (Householder
+  for 4 lines, Hadamard for 8). Every line feeds every other, so the echo
+  density builds up inside the loop rather than in the diffusers, and the
+  engine can run fewer all-passes in this mode. The lines are lane-packed -
+  one SIMD frame per sample - so reading, damping and mixing all the lines
+  costs a handful of register operations.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "LaneDelayLine.h"
+
+//==============================================================================
+// FDN - N damped delay lines mixed through an N x N orthogonal matrix
+//==============================================================================
+class FdnNetwork
+{
+public:
+    using SIMD = juce::dsp::SIMDRegister<float>;
+    static constexpr int laneWidth = LaneDelayLine::maxLanes;
+    static constexpr int maxLines = 8;
+    static constexpr int numBanks = (maxLines + laneWidth - 1) / laneWidth;
+
+    // The first four match the comb set so the 4-line network keeps its
+    // timing; the other four are primes above them
+    static constexpr int lineDelays[maxLines] = { 1116, 1188, 1277, 1356, 1433, 1487, 1559, 1613 };
+
+    // Allocates and clears all delay memory - keep this off the audio thread
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        for (auto& bank : banks)
+            bank.prepare(static_cast<int>(sampleRate * 0.1)); // 100ms max
+
+        setNumLines(numLines);
+    }
+
+    // Re-targets a lower rate inside the existing memory
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        updateDelayLengths();
+        updateGains();
+    }
+
+    // 4 (Householder) or 8 (Hadamard) lines; clears the network
+    void setNumLines(int newNumLines) noexcept
+    {
+        numLines = newNumLines > 4 ? 8 : 4;
+
+        updateDelayLengths();
+        updateMatrix();
+        updateGains();
+        reset();
+    }
+
+    int getNumLines() const noexcept { return numLines; }
+
+    void reset() noexcept
+    {
+        for (auto& bank : banks)
+            bank.reset();
+
+        std::fill(std::begin(filterState), std::end(filterState), SIMD(0.0f));
+    }
+
+    // The damping filters hold energy of their own, so they count too
+    float getStatePeak() const noexcept
+    {
+        auto range = juce::FloatVectorOperations::findMinAndMax(reinterpret_cast<const float*>(filterState), numBanks * laneWidth);
+        float peak = juce::jmax(-range.getStart(), range.getEnd());
+
+        for (auto& bank : banks)
+            peak = juce::jmax(peak, bank.getStatePeak());
+
+        return peak;
+    }
+
+    // Same RT60 mapping as the combs, worked out per line from its own length
+    void setParameters(float newDecayTime, float dampingFreq) noexcept
+    {
+        decayTime = newDecayTime;
+        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * dampingFreq / static_cast<float>(sampleRate));
+        updateGains();
+    }
+
+    // Input and output may be the same buffer
+    void process(const float* input, float* output, int numSamples) noexcept
+    {
+        const SIMD damping(dampingCoeff);
+        const SIMD outputScale(1.0f / static_cast<float>(numLines));
+        const bool householder = numLines == 4;
+
+        SIMD gain[numBanks], inputSign[numBanks], householderScale[numBanks];
+
+        for (int b = 0; b < numBanks; ++b)
+        {
+            gain[b] = SIMD::fromRawArray(lineGain + b * laneWidth);
+            inputSign[b] = SIMD::fromRawArray(lineInputSign + b * laneWidth);
+            householderScale[b] = SIMD::fromRawArray(lineHouseholderScale + b * laneWidth);
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            SIMD feedback[numBanks];
+
+            // Damped, decayed line outputs; unused lanes have zero gain
+            for (int b = 0; b < numBanks; ++b)
+            {
+                const SIMD delayed = banks[b].read();
+                filterState[b] = delayed + damping * (filterState[b] - delayed);
+                feedback[b] = gain[b] * filterState[b];
+            }
+
+            SIMD mixed[numBanks];
+
+            if (householder)
+            {
+                // (I - 2/N * 11^T) x: one horizontal sum, one broadcast
+                float total = 0.0f;
+                for (int b = 0; b < numBanks; ++b)
+                    total += feedback[b].sum();
+
+                for (int b = 0; b < numBanks; ++b)
+                    mixed[b] = feedback[b] - householderScale[b] * SIMD(total);
+            }
+            else
+            {
+                // Hadamard as a sum of broadcast lines times matrix columns
+                for (int b = 0; b < numBanks; ++b)
+                    mixed[b] = SIMD(0.0f);
+
+                for (int line = 0; line < numLines; ++line)
+                {
+                    const SIMD x(feedback[line / laneWidth].get(static_cast<size_t>(line % laneWidth)));
+
+                    for (int b = 0; b < numBanks; ++b)
+                        mixed[b] += matrixColumns[line][b] * x;
+                }
+            }
+
+            // Inject the input, write back and sum the lines for the output
+            const SIMD x(input[i]);
+            float out = 0.0f;
+
+            for (int b = 0; b < numBanks; ++b)
+            {
+                const SIMD y = inputSign[b] * x + mixed[b];
+                banks[b].write(y);
+                banks[b].advance();
+
+                out += (y * outputScale).sum();
+            }
+
+            output[i] = out;
+        }
+    }
+
+private:
+    void updateDelayLengths() noexcept
+    {
+        for (int line = 0; line < maxLines; ++line)
+            banks[line / laneWidth].setDelay(line % laneWidth,
+                                             juce::jmax(1, static_cast<int>(lineDelays[line] * sampleRate / 48000.0)));
+
+        // Lanes past the line count hold nothing, so reads skip their delays
+        for (int b = 0; b < numBanks; ++b)
+            banks[b].setActiveLanes(numLines - b * laneWidth);
+    }
+
+    void updateMatrix() noexcept
+    {
+        std::fill(std::begin(lineInputSign), std::end(lineInputSign), 0.0f);
+        std::fill(std::begin(lineHouseholderScale), std::end(lineHouseholderScale), 0.0f);
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            // Alternating signs keep the input off the Householder's
+            // all-ones eigenvector
+            lineInputSign[line] = (line & 1) != 0 ? -1.0f : 1.0f;
+            lineHouseholderScale[line] = 2.0f / static_cast<float>(numLines);
+        }
+
+        // Sylvester Hadamard, normalised: H[r][c] = (-1)^popcount(r & c) / sqrt(N)
+        const float norm = 1.0f / std::sqrt(static_cast<float>(numLines));
+
+        for (int c = 0; c < maxLines; ++c)
+        {
+            for (int b = 0; b < numBanks; ++b)
+            {
+                alignas(32) float column[laneWidth] = {};
+
+                for (int lane = 0; lane < laneWidth; ++lane)
+                {
+                    const int r = b * laneWidth + lane;
+
+                    if (r < numLines && c < numLines)
+                        column[lane] = (juce::countNumberOfBits(static_cast<juce::uint32>(r & c)) & 1) != 0 ? -norm : norm;
+                }
+
+                matrixColumns[c][b] = SIMD::fromRawArray(column);
+            }
+        }
+    }
+
+    void updateGains() noexcept
+    {
+        std::fill(std::begin(lineGain), std::end(lineGain), 0.0f);
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            const float delaySeconds = static_cast<float>(lineDelays[line]) / 48000.0f;
+            lineGain[line] = juce::jlimit(0.1f, 0.99f, std::pow(10.0f, -3.0f * delaySeconds / decayTime));
+        }
+    }
+
+    double sampleRate = 48000.0;
+    int numLines = 4;
+    float decayTime = 5.0f;
+    float dampingCoeff = 0.0f;
+
+    std::array<LaneDelayLine, numBanks> banks;
+    SIMD filterState[numBanks];
+    SIMD matrixColumns[maxLines][numBanks];
+
+    alignas(32) float lineGain[numBanks * laneWidth] = {};
+    alignas(32) float lineInputSign[numBanks * laneWidth] = {};
+    alignas(32) float lineHouseholderScale[numBanks * laneWidth] = {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FdnNetwork)
+};
@@ -0,0 +1,215 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Input Filter Bank
+  JUCE 8.0.11
+
+  Hi-shelf cut and low-cut ahead of the reverb network, built from
+  trapezoidal (TPT) state-variable sections. Every SIMD lane is an
+  independent channel with its own coefficients, so L/R (or several
+  engines) are filtered in a single pass. All state is per instance.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// One TPT SVF section, generic output mix: y = m0*x + m1*band + m2*low
+//==============================================================================
+struct SvfLaneSection
+{
+    using SIMD = juce::dsp::SIMDRegister<float>;
+    static constexpr int maxLanes = static_cast<int>(SIMD::size());
+
+    void reset() noexcept
+    {
+        ic1eq = 0.0f;
+        ic2eq = 0.0f;
+    }
+
+    // Hi shelf (Simper): gainDb < 0 cuts everything above the corner
+    void setHighShelf(int lane, double sampleRate, float freq, float q, float gainDb) noexcept
+    {
+        const float A = std::pow(10.0f, gainDb / 40.0f);
+        const float g = std::tan(juce::MathConstants<float>::pi * freq / static_cast<float>(sampleRate)) * std::sqrt(A);
+        const float k = 1.0f / q;
+
+        setLaneCoefficients(lane, g, k, A * A, k * (1.0f - A) * A, 1.0f - A * A);
+    }
+
+    // Passes the lane through untouched
+    void setBypass(int lane) noexcept
+    {
+        setLaneCoefficients(lane, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+    }
+
+    // 2nd-order high-pass
+    void setHighPass(int lane, double sampleRate, float freq, float q) noexcept
+    {
+        const float g = std::tan(juce::MathConstants<float>::pi * freq / static_cast<float>(sampleRate));
+        const float k = 1.0f / q;
+
+        setLaneCoefficients(lane, g, k, 1.0f, -k, -1.0f);
+    }
+
+    // Load the per-lane coefficient arrays into registers once per block
+    void loadCoefficients() noexcept
+    {
+        a1 = SIMD::fromRawArray(laneA1);
+        a2 = SIMD::fromRawArray(laneA2);
+        a3 = SIMD::fromRawArray(laneA3);
+        m0 = SIMD::fromRawArray(laneM0);
+        m1 = SIMD::fromRawArray(laneM1);
+        m2 = SIMD::fromRawArray(laneM2);
+    }
+
+    SIMD process(SIMD v0) noexcept
+    {
+        SIMD v3 = v0 - ic2eq;
+        SIMD v1 = a1 * ic1eq + a2 * v3;
+        SIMD v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+        ic1eq = v1 + v1 - ic1eq;
+        ic2eq = v2 + v2 - ic2eq;
+
+        return m0 * v0 + m1 * v1 + m2 * v2;
+    }
+
+    // True when every lane passes the signal through unchanged
+    bool isTransparent(int numLanes) const noexcept
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+            if (laneM0[lane] != 1.0f || laneM1[lane] != 0.0f || laneM2[lane] != 0.0f)
+                return false;
+
+        return true;
+    }
+
+private:
+    void setLaneCoefficients(int lane, float g, float k, float mix0, float mix1, float mix2) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(lane, maxLanes));
+
+        laneA1[lane] = 1.0f / (1.0f + g * (g + k));
+        laneA2[lane] = g * laneA1[lane];
+        laneA3[lane] = g * laneA2[lane];
+        laneM0[lane] = mix0;
+        laneM1[lane] = mix1;
+        laneM2[lane] = mix2;
+    }
+
+    SIMD ic1eq { 0.0f }, ic2eq { 0.0f };
+    SIMD a1 { 0.0f }, a2 { 0.0f }, a3 { 0.0f }, m0 { 1.0f }, m1 { 0.0f }, m2 { 0.0f };
+
+    alignas(32) float laneA1[maxLanes] = {};
+    alignas(32) float laneA2[maxLanes] = {};
+    alignas(32) float laneA3[maxLanes] = {};
+    alignas(32) float laneM0[maxLanes] = {};
+    alignas(32) float laneM1[maxLanes] = {};
+    alignas(32) float laneM2[maxLanes] = {};
+};
+
+//==============================================================================
+// Input Filter Bank - hi-shelf cut followed by low-cut, one lane per channel
+//==============================================================================
+class InputFilterBank
+{
+public:
+    static constexpr int maxLanes = SvfLaneSection::maxLanes;
+
+    // Hi-shelf corner of the DDX3216 "Hi Cut" control
+    static constexpr float hiShelfFreq = 5000.0f;
+
+    // Low-cut setting (and below) that leaves the input untouched. It is the
+    // parameter's default, so sessions from before the low-cut sound the same.
+    static constexpr float lowCutOffHz = 20.0f;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        for (int lane = 0; lane < maxLanes; ++lane)
+        {
+            lastHiCutDb[lane] = lastLowCutHz[lane] = -1.0f;
+            setLane(lane, 0.0f, lowCutOffHz);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        hiShelf.reset();
+        lowCut.reset();
+    }
+
+    // Coefficients are only recomputed when a lane's settings change
+    void setLane(int lane, float hiCutDb, float lowCutHz) noexcept
+    {
+        if (hiCutDb != lastHiCutDb[lane])
+        {
+            hiShelf.setHighShelf(lane, sampleRate, hiShelfFreq, juce::MathConstants<float>::sqrt2 * 0.5f, -hiCutDb);
+            lastHiCutDb[lane] = hiCutDb;
+        }
+
+        if (lowCutHz != lastLowCutHz[lane])
+        {
+            if (lowCutHz > lowCutOffHz)
+                lowCut.setHighPass(lane, sampleRate, lowCutHz, juce::MathConstants<float>::sqrt2 * 0.5f);
+            else
+                lowCut.setBypass(lane);
+
+            lastLowCutHz[lane] = lowCutHz;
+        }
+    }
+
+    // Filters up to maxLanes channels in place
+    void process(float* const* lanes, int numLanes, int numSamples) noexcept
+    {
+        using SIMD = SvfLaneSection::SIMD;
+        numLanes = juce::jmin(numLanes, maxLanes);
+
+        // Sections with no cut dialled in are skipped and start clean next time
+        const bool useShelf = !hiShelf.isTransparent(numLanes);
+        if (!useShelf)
+            hiShelf.reset();
+
+        const bool useLowCut = !lowCut.isTransparent(numLanes);
+        if (!useLowCut)
+            lowCut.reset();
+
+        if (!useShelf && !useLowCut)
+            return;
+
+        hiShelf.loadCoefficients();
+        lowCut.loadCoefficients();
+
+        alignas(32) float frame[maxLanes] = {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+                frame[lane] = lanes[lane][i];
+
+            SIMD x = SIMD::fromRawArray(frame);
+
+            if (useShelf)
+                x = hiShelf.process(x);
+
+            if (useLowCut)
+                x = lowCut.process(x);
+
+            x.copyToRawArray(frame);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                lanes[lane][i] = frame[lane];
+        }
+    }
+
+private:
+    double sampleRate = 48000.0;
+
+    SvfLaneSection hiShelf;
+    SvfLaneSection lowCut;
+
+    float lastHiCutDb[maxLanes] = {};
+    float lastLowCutHz[maxLanes] = {};
+};
@@ -0,0 +1,132 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Lane-Packed Delay Line
+  JUCE 8.0.11
+
+  A delay line holding one SIMD frame per sample. All lanes share the write
+  head, and each lane reads back at its own delay, so a single line can
+  carry several independent delays that are written in one store. A read
+  is one frame load at lane 0's delay; each lane in use at a different
+  delay costs one more frame load, masked to that lane and added in.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// One lane-packed delay line: a frame per sample, a delay per lane
+//==============================================================================
+struct LaneDelayLine
+{
+    using SIMD = juce::dsp::SIMDRegister<float>;
+    static constexpr int maxLanes = static_cast<int>(SIMD::size());
+
+    // Allocates and clears - keep this off the audio thread
+    void prepare(int maxDelaySamples)
+    {
+        frames.resize(static_cast<size_t>(maxDelaySamples + 1));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill(frames.begin(), frames.end(), SIMD(0.0f));
+        writePos = 0;
+    }
+
+    int getMaxDelay() const noexcept { return static_cast<int>(frames.size()) - 1; }
+
+    void setDelay(int lane, int delaySamples) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(lane, maxLanes));
+        delays[lane] = juce::jlimit(0, getMaxDelay(), delaySamples);
+        updateOffsetLanes();
+    }
+
+    // Lanes from numLanes up carry nothing, so their delays don't matter
+    void setActiveLanes(int numLanes) noexcept
+    {
+        activeLanes = juce::jlimit(1, maxLanes, numLanes);
+        updateOffsetLanes();
+    }
+
+    // Each lane's sample from its own delay back (0 = what was just written)
+    SIMD read() const noexcept
+    {
+        const SIMD& frame = frames[static_cast<size_t>(getReadPos(delays[0]))];
+
+        if (numOffsetLanes == 0)
+            return frame;
+
+        // Whole-frame loads and masks only - writing single lanes into a
+        // register would stall on the store every sample
+        SIMD result = frame & sharedLanesMask;
+
+        for (int i = 0; i < numOffsetLanes; ++i)
+        {
+            const int lane = offsetLanes[i];
+            result += frames[static_cast<size_t>(getReadPos(delays[lane]))] & offsetLaneMasks[i];
+        }
+
+        return result;
+    }
+
+    void write(SIMD frame) noexcept { frames[static_cast<size_t>(writePos)] = frame; }
+
+    void advance() noexcept
+    {
+        if (++writePos >= static_cast<int>(frames.size()))
+            writePos = 0;
+    }
+
+    // Largest magnitude held in any lane
+    float getStatePeak() const noexcept
+    {
+        if (frames.empty())
+            return 0.0f;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(reinterpret_cast<const float*>(frames.data()),
+                                                                 static_cast<int>(frames.size()) * maxLanes);
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+
+    std::vector<SIMD> frames;
+    int writePos = 0;
+    int delays[maxLanes] = {};
+    int activeLanes = maxLanes;
+
+private:
+    int getReadPos(int delay) const noexcept
+    {
+        const int readPos = writePos - delay;
+        return readPos < 0 ? readPos + static_cast<int>(frames.size()) : readPos;
+    }
+
+    // Lanes in use whose delay differs from lane 0's, and the masks that
+    // pick them out of their own frames
+    void updateOffsetLanes() noexcept
+    {
+        alignas(32) SIMD::MaskType shared[maxLanes];
+        std::fill(std::begin(shared), std::end(shared), ~SIMD::MaskType());
+        numOffsetLanes = 0;
+
+        for (int lane = 1; lane < activeLanes; ++lane)
+        {
+            if (delays[lane] == delays[0])
+                continue;
+
+            alignas(32) SIMD::MaskType single[maxLanes] = {};
+            single[lane] = ~SIMD::MaskType();
+            shared[lane] = 0;
+
+            offsetLaneMasks[numOffsetLanes] = SIMD::vMaskType::fromRawArray(single);
+            offsetLanes[numOffsetLanes++] = lane;
+        }
+
+        sharedLanesMask = SIMD::vMaskType::fromRawArray(shared);
+    }
+
+    SIMD::vMaskType sharedLanesMask;
+    SIMD::vMaskType offsetLaneMasks[maxLanes];
+    int offsetLanes[maxLanes] = {};
+    int numOffsetLanes = 0;
+};
@@ -0,0 +1,239 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Lane-Packed Reverb Network
+  JUCE 8.0.11
+
+  The DDX3216 network (pre-delay -> 4 parallel combs -> 8 series all-passes)
+  with one independent network per SIMD lane. Every delay line stores one
+  register-wide frame per sample and shares a write head across lanes;
+  each lane reads back at its own delay, so lanes can differ in length,
+  pre-delay and coefficients while the arithmetic runs once for all of
+  them. Each read is one frame load plus a patch for every lane in use
+  at a different delay, so lanes left at the same delays cost nothing
+  extra. Same per-sample topology as SharcCombFilter / SharcAllpassFilter.
+
+  The delay tables, all-pass count and decay range come from the reverb
+  program, shared by every lane. Only the comb/all-pass network is here:
+  no early reflections, gate, modulation, low band or other algorithms.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ReverbEngine.h"
+#include "LaneDelayLine.h"
+
+//==============================================================================
+// Lane Reverb Network - up to SIMD::size() independent networks per pass
+//==============================================================================
+class LaneReverbNetwork
+{
+public:
+    using SIMD = juce::dsp::SIMDRegister<float>;
+    static constexpr int maxLanes = LaneDelayLine::maxLanes;
+    static constexpr int numCombs = DdxReverbEngine::numCombs;
+    static constexpr int numAllpasses = DdxReverbEngine::numAllpasses;
+
+    // Allocates and clears all delay memory - keep this off the audio thread
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        preDelay.prepare(static_cast<int>(sampleRate * 0.5)); // 500ms max
+
+        for (auto& comb : combs)
+            comb.prepare(static_cast<int>(sampleRate * 0.1)); // 100ms max
+
+        for (auto& ap : allpasses)
+            ap.prepare(static_cast<int>(sampleRate * 0.05)); // 50ms max
+
+        for (int lane = 0; lane < maxLanes; ++lane)
+        {
+            updateLaneDelays(lane);
+            setLaneParameters(lane, 5.0f, 0.0f, 50.0f, 10.0f);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        preDelay.reset();
+
+        for (auto& comb : combs)
+            comb.reset();
+
+        for (auto& ap : allpasses)
+            ap.reset();
+
+        std::fill(std::begin(combFilterState), std::end(combFilterState), SIMD(0.0f));
+    }
+
+    // Switches every lane to the program's delay tables, without a crossfade.
+    // All-passes the program doesn't use are cleared, so they hold no tail.
+    void setProgram(ReverbProgram newProgram) noexcept
+    {
+        if (newProgram == program)
+            return;
+
+        program = newProgram;
+        tables = DdxReverbEngine::getProgramTables(program);
+
+        for (int lane = 0; lane < maxLanes; ++lane)
+        {
+            updateLaneDelays(lane);
+            updateLaneCombGain(lane);
+        }
+
+        for (int a = tables.maxAllpasses; a < numAllpasses; ++a)
+            allpasses[a].reset();
+    }
+
+    // Offsets every comb and all-pass of one lane by a number of 48kHz samples
+    void setLaneSpread(int lane, int spreadSamples) noexcept
+    {
+        laneSpread[lane] = spreadSamples;
+        updateLaneDelays(lane);
+    }
+
+    // Same front-panel mapping as DdxReverbEngine::setParameters
+    void setLaneParameters(int lane, float decayTime, float predelayMs, float dampingPct, float diffusion) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(lane, maxLanes));
+        const auto rate = static_cast<float>(sampleRate);
+
+        preDelay.setDelay(lane, static_cast<int>(predelayMs * rate / 1000.0f));
+
+        laneDecayTime[lane] = decayTime;
+        updateLaneCombGain(lane);
+        laneDamping[lane] = std::exp(-juce::MathConstants<float>::twoPi * DdxReverbEngine::getDampingFreq(dampingPct) / rate);
+        laneAllpassGain[lane] = DdxReverbEngine::getAllpassGain(diffusion);
+    }
+
+    float getStatePeak() const noexcept
+    {
+        auto range = juce::FloatVectorOperations::findMinAndMax(reinterpret_cast<const float*>(combFilterState), numCombs * maxLanes);
+        float peak = juce::jmax(preDelay.getStatePeak(), -range.getStart(), range.getEnd());
+
+        for (auto& comb : combs)
+            peak = juce::jmax(peak, comb.getStatePeak());
+
+        for (auto& ap : allpasses)
+            peak = juce::jmax(peak, ap.getStatePeak());
+
+        return peak;
+    }
+
+    // Runs lanes[0..numLanes) through their networks in place
+    void process(float* const* lanes, int numLanes, int numSamples) noexcept
+    {
+        numLanes = juce::jmin(numLanes, maxLanes);
+
+        if (numLanes != activeLanes)
+            setActiveLanes(numLanes);
+
+        const auto combGain = SIMD::fromRawArray(laneCombGain);
+        const auto damping = SIMD::fromRawArray(laneDamping);
+        const auto apGain = SIMD::fromRawArray(laneAllpassGain);
+        const SIMD combScale(1.0f / numCombs);
+        const int numActiveAllpasses = tables.maxAllpasses;
+
+        alignas(32) float frame[maxLanes] = {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+                frame[lane] = lanes[lane][i];
+
+            // Pre-delay - write first so a zero delay passes straight through
+            preDelay.write(SIMD::fromRawArray(frame));
+            const SIMD x = preDelay.read();
+            preDelay.advance();
+
+            // Parallel feedback combs with one-pole damping in the loop
+            SIMD sum(0.0f);
+
+            for (int c = 0; c < numCombs; ++c)
+            {
+                auto& comb = combs[c];
+                auto& flt = combFilterState[c];
+
+                const SIMD delayed = comb.read();
+                flt = delayed + damping * (flt - delayed);
+
+                const SIMD y = x + combGain * flt;
+                comb.write(y);
+                comb.advance();
+
+                sum += y;
+            }
+
+            // Series all-passes: y = -g*x + d, store x + g*d
+            SIMD y = sum * combScale;
+
+            for (int a = 0; a < numActiveAllpasses; ++a)
+            {
+                auto& ap = allpasses[a];
+                const SIMD delayed = ap.read();
+                ap.write(y + apGain * delayed);
+                ap.advance();
+
+                y = delayed - apGain * y;
+            }
+
+            y.copyToRawArray(frame);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                lanes[lane][i] = frame[lane];
+        }
+    }
+
+private:
+    void setActiveLanes(int numLanes) noexcept
+    {
+        activeLanes = numLanes;
+        preDelay.setActiveLanes(numLanes);
+
+        for (auto& comb : combs)
+            comb.setActiveLanes(numLanes);
+
+        for (auto& ap : allpasses)
+            ap.setActiveLanes(numLanes);
+    }
+
+    void updateLaneDelays(int lane) noexcept
+    {
+        const double scale = sampleRate / 48000.0;
+        const int spread = laneSpread[lane];
+
+        for (int c = 0; c < numCombs; ++c)
+            combs[c].setDelay(lane, juce::jmax(1, static_cast<int>((tables.combDelays[c] + spread) * scale)));
+
+        for (int a = 0; a < numAllpasses; ++a)
+            allpasses[a].setDelay(lane, juce::jmax(1, static_cast<int>((tables.allpassDelays[a] + spread) * scale)));
+    }
+
+    // Each program covers its own slice of the Decay range
+    void updateLaneCombGain(int lane) noexcept
+    {
+        laneCombGain[lane] = DdxReverbEngine::getCombGain(laneDecayTime[lane] * tables.decayScale,
+                                                          static_cast<float>(sampleRate), tables.combDelays);
+    }
+
+    double sampleRate = 48000.0;
+
+    LaneDelayLine preDelay;
+    std::array<LaneDelayLine, numCombs> combs;
+    std::array<LaneDelayLine, numAllpasses> allpasses;
+    SIMD combFilterState[numCombs];
+
+    ReverbProgram program = ReverbProgram::cathedral;
+    DdxReverbEngine::ProgramTables tables = DdxReverbEngine::getProgramTables(ReverbProgram::cathedral);
+
+    int laneSpread[maxLanes] = {};
+    int activeLanes = maxLanes;
+    float laneDecayTime[maxLanes] = {};
+    alignas(32) float laneCombGain[maxLanes] = {};
+    alignas(32) float laneDamping[maxLanes] = {};
+    alignas(32) float laneAllpassGain[maxLanes] = {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LaneReverbNetwork)
+};
@@ -0,0 +1,185 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Low Band Network
+  JUCE 8.0.11
+
+  The DDX3216 "Bass Multiply" control: the lows are split off ahead of the
+  combs and decay through a comb set of their own, running at a quarter of
+  the engine rate, so the low band can ring longer or shorter than the
+  rest. At 1/4 rate the extra combs cost about a quarter of a second
+  full-rate set.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SharcFilters.h"
+#include "PolyphaseResampler.h"
+
+//==============================================================================
+// Low Band Network - crossover -> decimate -> 4 parallel combs -> interpolate
+//==============================================================================
+class LowBandNetwork
+{
+public:
+    static constexpr int numCombs = 4;
+    static constexpr int decimationFactor = 4;
+    static constexpr float crossoverFreq = 200.0f;
+
+    // Primes at 48kHz, placed between the main comb set's delays
+    static constexpr int combDelays[numCombs] = { 1151, 1237, 1319, 1423 };
+
+    // Allocates and clears all delay memory - keep this off the audio thread
+    void prepare(double newSampleRate, int maxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        const double lowRate = sampleRate / decimationFactor;
+
+        lowScratch.resize(static_cast<size_t>(maxBlockSize));
+        internalScratch.resize(static_cast<size_t>(maxBlockSize / decimationFactor + 2));
+        internalSum.resize(internalScratch.size());
+        internalCombOut.resize(internalScratch.size());
+
+        int maxCombDelay = static_cast<int>(lowRate * 0.1); // 100ms max
+        for (auto& comb : combs)
+            comb.prepare(lowRate, maxCombDelay, 0.7f, 5000.0f);
+
+        resampler.setFactor(decimationFactor);
+        updateRate();
+        reset();
+    }
+
+    // Re-targets a lower rate inside the existing memory
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+
+        for (auto& comb : combs)
+            comb.setSampleRate(sampleRate / decimationFactor);
+
+        updateRate();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& comb : combs)
+            comb.reset();
+
+        resampler.reset();
+        ic1eq = ic2eq = 0.0f;
+    }
+
+    float getStatePeak() const noexcept
+    {
+        float peak = juce::jmax(std::abs(ic1eq), std::abs(ic2eq));
+
+        for (auto& comb : combs)
+            peak = juce::jmax(peak, comb.getStatePeak());
+
+        return peak;
+    }
+
+    // decayTime is the low band's own RT60, i.e. already multiplied
+    void setParameters(float decayTime, float dampingFreq) noexcept
+    {
+        float avgDelaySeconds = 0.0f;
+        for (auto delay : combDelays)
+            avgDelaySeconds += static_cast<float>(delay) / (48000.0f * numCombs);
+
+        float combGain = std::pow(10.0f, -3.0f * avgDelaySeconds / decayTime);
+        combGain = juce::jlimit(0.1f, 0.99f, combGain);
+
+        for (auto& comb : combs)
+        {
+            comb.setDampingFreq(dampingFreq);
+            comb.setGain(combGain);
+        }
+    }
+
+    // Removes the low band from data in place and writes its reverberated
+    // version (already scaled for the comb sum) to the returned buffer
+    const float* process(float* data, int numSamples, bool useSIMD) noexcept
+    {
+        split(data, numSamples);
+        return processSplit(numSamples, useSIMD);
+    }
+
+    // The two halves of process(): after split() the caller is free to work
+    // on data while processSplit() reverberates the low band on another thread
+    void split(float* data, int numSamples) noexcept
+    {
+        jassert(numSamples <= static_cast<int>(lowScratch.size()));
+        auto* low = lowScratch.data();
+
+        // 2nd-order TPT low-pass; the high band is the exact complement
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float v3 = data[i] - ic2eq;
+            const float v1 = a1 * ic1eq + a2 * v3;
+            const float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+            ic1eq = 2.0f * v1 - ic1eq;
+            ic2eq = 2.0f * v2 - ic2eq;
+
+            low[i] = v2;
+            data[i] -= v2;
+        }
+    }
+
+    const float* processSplit(int numSamples, bool useSIMD) noexcept
+    {
+        auto* low = lowScratch.data();
+        auto* internal = internalScratch.data();
+        auto* sum = internalSum.data();
+        auto* combOut = internalCombOut.data();
+        const int numInternal = resampler.decimate(low, numSamples, internal);
+
+        for (int c = 0; c < numCombs; ++c)
+        {
+            auto* out = c == 0 ? sum : combOut;
+
+            if (useSIMD)
+                combs[c].processBlockSIMD(internal, out, numInternal);
+            else
+                combs[c].processBlockScalar(internal, out, numInternal);
+
+            if (c > 0)
+                juce::FloatVectorOperations::add(sum, out, numInternal);
+        }
+
+        juce::FloatVectorOperations::multiply(sum, 1.0f / numCombs, numInternal);
+        resampler.interpolate(sum, numInternal, low, numSamples);
+
+        return low;
+    }
+
+private:
+    void updateRate() noexcept
+    {
+        const double lowRate = sampleRate / decimationFactor;
+
+        for (int i = 0; i < numCombs; ++i)
+            combs[i].setDelaySamples(static_cast<int>(combDelays[i] * lowRate / 48000.0));
+
+        const float g = std::tan(juce::MathConstants<float>::pi * crossoverFreq / static_cast<float>(sampleRate));
+        const float k = juce::MathConstants<float>::sqrt2;
+
+        a1 = 1.0f / (1.0f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
+
+    double sampleRate = 48000.0;
+
+    std::array<SharcCombFilter, numCombs> combs;
+    PolyphaseResampler resampler;
+
+    // Crossover state and coefficients
+    float ic1eq = 0.0f, ic2eq = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+
+    std::vector<float> lowScratch;
+    std::vector<float> internalScratch;
+    std::vector<float> internalSum;
+    std::vector<float> internalCombOut;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LowBandNetwork)
+};
@@ -0,0 +1,64 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Mixed-Precision Helpers
+  JUCE 8.0.11
+
+  Block operations between float and double sample buffers, for the
+  double-precision host path and the engine's wide accumulators. Where both
+  sides are the same type they forward to FloatVectorOperations, so the
+  float path compiles to exactly what it did before.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace MixedPrecision
+{
+    template <typename DestType, typename SourceType>
+    void copy(DestType* dest, const SourceType* source, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<DestType, SourceType>)
+            juce::FloatVectorOperations::copy(dest, source, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = static_cast<DestType>(source[i]);
+    }
+
+    template <typename DestType, typename SourceType>
+    void add(DestType* dest, const SourceType* source, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<DestType, SourceType>)
+            juce::FloatVectorOperations::add(dest, source, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] += static_cast<DestType>(source[i]);
+    }
+
+    template <typename DestType, typename SourceType>
+    void addWithMultiply(DestType* dest, const SourceType* source, DestType gain, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<DestType, SourceType>)
+            juce::FloatVectorOperations::addWithMultiply(dest, source, gain, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] += static_cast<DestType>(source[i]) * gain;
+    }
+
+    // Same as SmoothedValue::applyGain for float blocks
+    template <typename SampleType>
+    void applyGain(juce::SmoothedValue<float>& gain, SampleType* data, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            gain.applyGain(data, numSamples);
+        }
+        else if (gain.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= gain.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply(data, static_cast<SampleType>(gain.getTargetValue()), numSamples);
+        }
+    }
+}
@@ -0,0 +1,285 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Modulated Delay Reads
+  JUCE 8.0.11
+
+  Fractional read positions for the comb and all-pass delay lines, and the
+  slow LFOs that move them. Integer, fixed delays ring metallically; a read
+  point drifting by a few samples breaks up the resonances without the
+  pitch wobble of a chorus.
+
+  The LFOs only run at control rate: every stage's sine advances together
+  once per controlInterval samples (a rotation, no trig), and the delay is
+  ramped linearly in between. Interpolation works on spans no longer than
+  the shortest delay in them, so a span only reads memory written before it
+  starts; the taps for a whole span are gathered first and the polynomial
+  then runs on SIMD registers.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Interpolation for fractional reads
+//==============================================================================
+enum class DelayInterpolation
+{
+    linear,   // 2 taps
+    lagrange3 // 4 taps, 3rd-order Lagrange - flatter response, less HF loss
+};
+
+namespace FractionalDelay
+{
+    // Longest span interpolated at once
+    constexpr int maxSpan = 64;
+
+    // A span of n samples needs every delay in it to be at least n + reach,
+    // so the newest tap (delay - 1 for Lagrange) was written before the span
+    constexpr int reach = 2;
+
+    // Longest span the given delays allow, between 1 and maxSpan
+    inline int getSpanLength(const float* delays, int numSamples) noexcept
+    {
+        const float shortest = juce::FloatVectorOperations::findMinimum(delays, juce::jmin(numSamples, maxSpan));
+        return juce::jlimit(1, juce::jmin(numSamples, maxSpan), static_cast<int>(shortest) - reach);
+    }
+
+    // output[i] = the ring's contents delays[i] samples before sample i of a
+    // span that will be written from writeIndex on. Delays must stay within
+    // [getSpanLength() + reach, ringSize - 3]. output must be aligned and
+    // hold maxSpan samples; lanes past numSamples are scratch.
+    template <DelayInterpolation interpolation>
+    void read(const float* ring, int ringSize, int writeIndex, const float* delays, float* output, int numSamples) noexcept
+    {
+        using SIMD = juce::dsp::SIMDRegister<float>;
+        constexpr int simdWidth = static_cast<int>(SIMD::size());
+
+        jassert(numSamples <= maxSpan);
+
+        // Taps by age: newer (delay D - 1), x0 (D), x1 (D + 1), older (D + 2)
+        alignas(32) float newer[maxSpan];
+        alignas(32) float x0[maxSpan];
+        alignas(32) float x1[maxSpan];
+        alignas(32) float older[maxSpan];
+        alignas(32) float frac[maxSpan];
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(delays, numSamples);
+        const int firstTap = writeIndex - static_cast<int>(range.getEnd()) - 2;
+        const int lastTap = writeIndex + numSamples - static_cast<int>(range.getStart());
+
+        if (firstTap >= 0 && lastTap < ringSize)
+        {
+            // Usual case: every tap of the span is in one piece of the ring
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const int whole = static_cast<int>(delays[i]);
+                const float* tap = ring + writeIndex + i - whole;
+
+                frac[i] = delays[i] - static_cast<float>(whole);
+                x0[i] = tap[0];
+                x1[i] = tap[-1];
+
+                if constexpr (interpolation == DelayInterpolation::lagrange3)
+                {
+                    newer[i] = tap[1];
+                    older[i] = tap[-2];
+                }
+            }
+        }
+        else
+        {
+            const auto wrap = [ringSize](int index) noexcept
+            {
+                return index < 0 ? index + ringSize : (index >= ringSize ? index - ringSize : index);
+            };
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const int whole = static_cast<int>(delays[i]);
+                const int index = wrap(writeIndex + i - whole);
+
+                frac[i] = delays[i] - static_cast<float>(whole);
+                x0[i] = ring[index];
+                x1[i] = ring[wrap(index - 1)];
+
+                if constexpr (interpolation == DelayInterpolation::lagrange3)
+                {
+                    newer[i] = ring[wrap(index + 1)];
+                    older[i] = ring[wrap(index - 2)];
+                }
+            }
+        }
+
+        // Silence in the lanes past the end of the span
+        const int paddedLength = (numSamples + simdWidth - 1) / simdWidth * simdWidth;
+
+        for (int i = numSamples; i < paddedLength; ++i)
+            newer[i] = x0[i] = x1[i] = older[i] = frac[i] = 0.0f;
+
+        for (int i = 0; i < paddedLength; i += simdWidth)
+        {
+            const SIMD t = SIMD::fromRawArray(frac + i);
+            const SIMD a = SIMD::fromRawArray(x0 + i);
+            const SIMD b = SIMD::fromRawArray(x1 + i);
+
+            if constexpr (interpolation == DelayInterpolation::linear)
+            {
+                (a + t * (b - a)).copyToRawArray(output + i);
+            }
+            else
+            {
+                // Lagrange through delays D-1..D+2 in Horner form
+                const SIMD n = SIMD::fromRawArray(newer + i);
+                const SIMD o = SIMD::fromRawArray(older + i);
+                const SIMD half(0.5f), third(1.0f / 3.0f), sixth(1.0f / 6.0f);
+
+                const SIMD c1 = b - n * third - a * half - o * sixth;
+                const SIMD c2 = (n + b) * half - a;
+                const SIMD c3 = (o - n) * sixth + (a - b) * half;
+
+                (a + t * (c1 + t * (c2 + t * c3))).copyToRawArray(output + i);
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Delay Modulator - one slow sine per stage, stepped at control rate
+//==============================================================================
+class DelayModulator
+{
+public:
+    static constexpr int maxStages = 8;
+    static constexpr int controlInterval = 32;
+
+    // Each stage runs at its own multiple of the rate and starts at its own
+    // phase, so no two read points move together
+    static constexpr float rateSpread[maxStages] = { 1.0f, 1.17f, 0.83f, 1.31f, 0.91f, 1.09f, 0.77f, 1.23f };
+
+    void prepare(double newSampleRate, int maxBlockSize)
+    {
+        knots.resize(static_cast<size_t>((maxBlockSize / controlInterval + 3) * maxStages));
+        sampleRate = newSampleRate;
+        updateSteps();
+        reset();
+    }
+
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        updateSteps();
+    }
+
+    void setRate(float newRateHz) noexcept
+    {
+        if (newRateHz == rateHz)
+            return;
+
+        rateHz = newRateHz;
+        updateSteps();
+    }
+
+    void reset() noexcept
+    {
+        for (int k = 0; k < maxStages; ++k)
+        {
+            const float phase = juce::MathConstants<float>::twoPi * 0.618034f * static_cast<float>(k);
+            sinValues[static_cast<size_t>(k)] = std::sin(phase);
+            cosValues[static_cast<size_t>(k)] = std::cos(phase);
+        }
+
+        position = 0;
+        blockOffset = 0;
+    }
+
+    // Steps every stage's LFO across the next block, once per control
+    // interval, keeping the values at each step for getDelays()
+    void advance(int numSamples) noexcept
+    {
+        blockOffset = position;
+
+        const int numKnots = (position + numSamples - 1) / controlInterval + 2;
+        const int numSteps = (position + numSamples) / controlInterval;
+        auto s = sinValues;
+        auto c = cosValues;
+
+        for (int j = 0; j < numKnots; ++j)
+        {
+            // The next block starts from the last step this one passes
+            if (j == numSteps)
+            {
+                sinValues = s;
+                cosValues = c;
+            }
+
+            std::copy(s.begin(), s.end(), knots.begin() + j * maxStages);
+
+            // All stages at once - a few vector multiply-adds
+            for (size_t k = 0; k < maxStages; ++k)
+            {
+                const float nextSin = s[k] * stepCos[k] + c[k] * stepSin[k];
+                c[k] = c[k] * stepCos[k] - s[k] * stepSin[k];
+                s[k] = nextSin;
+            }
+        }
+
+        // Pull the rotations back onto the unit circle
+        for (size_t k = 0; k < maxStages; ++k)
+        {
+            const float gain = 1.5f - 0.5f * (sinValues[k] * sinValues[k] + cosValues[k] * cosValues[k]);
+            sinValues[k] *= gain;
+            cosValues[k] *= gain;
+        }
+
+        position = (position + numSamples) % controlInterval;
+    }
+
+    // Per-sample delay for one stage over the block advance() covered:
+    // baseDelay +- excursion, ramped between control steps
+    void getDelays(int stage, float baseDelay, float excursion, float* delays, int numSamples) const noexcept
+    {
+        const float rampScale = excursion / static_cast<float>(controlInterval);
+        int i = 0;
+
+        for (int j = 0; i < numSamples; ++j)
+        {
+            const float from = knots[static_cast<size_t>(j * maxStages + stage)];
+            const float to = knots[static_cast<size_t>((j + 1) * maxStages + stage)];
+            const float step = (to - from) * rampScale;
+            const int end = juce::jmin(numSamples, (j + 1) * controlInterval - blockOffset);
+
+            float delay = baseDelay + excursion * from + step * static_cast<float>(j == 0 ? blockOffset : 0);
+
+            for (; i < end; ++i)
+            {
+                delays[i] = delay;
+                delay += step;
+            }
+        }
+    }
+
+private:
+    void updateSteps() noexcept
+    {
+        for (int k = 0; k < maxStages; ++k)
+        {
+            const double angle = juce::MathConstants<double>::twoPi * rateHz * rateSpread[k] * controlInterval / sampleRate;
+            stepSin[static_cast<size_t>(k)] = static_cast<float>(std::sin(angle));
+            stepCos[static_cast<size_t>(k)] = static_cast<float>(std::cos(angle));
+        }
+    }
+
+    double sampleRate = 48000.0;
+    float rateHz = 0.5f;
+
+    std::array<float, maxStages> sinValues {};
+    std::array<float, maxStages> cosValues {};
+    std::array<float, maxStages> stepSin {};
+    std::array<float, maxStages> stepCos {};
+
+    // LFO values at each control step of the current block, stage-interleaved
+    std::vector<float> knots;
+    int position = 0;    // samples since the last control step
+    int blockOffset = 0; // position at the start of the current block
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayModulator)
+};
@@ -0,0 +1,195 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Offline Render Pool
+  JUCE 8.0.11
+
+  Fork/join helpers. Independent parts of a block (the low band, the two
+  engines of a crossfade, lane networks) are handed to a RenderTaskPool as
+  numbered tasks. Each task writes only its own output, and callers combine
+  the results afterwards in a fixed order, so the result does not depend
+  on which pool ran it - or whether one did at all.
+
+  OfflineRenderPool is the plugin's own pool for bounces, where there is no
+  deadline to protect. A plugin format with a host thread pool (CLAP)
+  supplies its own RenderTaskPool instead.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Render Task Pool - runs task(0..n) and joins before returning
+//==============================================================================
+class RenderTaskPool
+{
+public:
+    // Fixed capture storage, so forking never allocates on the audio thread
+    using Task = juce::dsp::FixedSizeFunction<64, void(int)>;
+
+    // Never more tasks than the widest fork in the processor
+    static constexpr int maxTasks = 4;
+
+    // Blocks shorter than this are not worth waking the workers for
+    static constexpr int minParallelSamples = 64;
+
+    virtual ~RenderTaskPool() = default;
+
+    virtual void forEach(int numTasks, const Task& task) = 0;
+};
+
+//==============================================================================
+// Offline Render Pool - a few plugin-owned threads for bounces
+//==============================================================================
+class OfflineRenderPool : public RenderTaskPool
+{
+public:
+    // One core is the calling thread's; the rest get a worker each
+    explicit OfflineRenderPool(int numCores = juce::SystemStats::getNumCpus())
+    {
+        const int numWorkers = juce::jlimit(1, maxTasks - 1, numCores - 1);
+
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add(new Worker(*this))->startThread();
+    }
+
+    ~OfflineRenderPool() override
+    {
+        for (auto* worker : workers)
+        {
+            worker->signalThreadShouldExit();
+            worker->wake.signal();
+        }
+
+        for (auto* worker : workers)
+            worker->stopThread(2000);
+    }
+
+    // Tasks are claimed from a shared counter by the calling thread and the
+    // workers alike, so a fork made from inside a task (or with every worker
+    // busy) still completes: the caller simply runs whatever is unclaimed
+    void forEach(int numTasks, const Task& task) override
+    {
+        jassert(numTasks <= maxTasks);
+
+        auto* fork = numTasks >= 2 ? claimFork() : nullptr;
+
+        // Too small, or every fork slot is taken by nested forks: run here
+        if (fork == nullptr)
+        {
+            for (int i = 0; i < numTasks; ++i)
+                task(i);
+
+            return;
+        }
+
+        fork->numTasks = numTasks;
+        fork->task = &task;
+        fork->next = 0;
+        fork->completed = 0;
+        fork->state = Fork::active;
+
+        for (auto* worker : workers)
+            worker->wake.signal();
+
+        fork->runTasks();
+        fork->done.wait();
+        releaseFork(*fork);
+    }
+
+private:
+    // Preallocated and reused, so a fork costs no allocation. A worker can
+    // still be looking at a fork after its last task is done, so a slot is
+    // only handed out again once nobody is.
+    struct Fork
+    {
+        enum State { free, claimed, active, finishing };
+
+        void runTasks()
+        {
+            for (int i = next++; i < numTasks; i = next++)
+            {
+                (*task)(i);
+
+                if (++completed == numTasks)
+                    done.signal();
+            }
+        }
+
+        std::atomic<int> state { free };
+        std::atomic<int> users { 0 };
+        int numTasks = 0;
+        const Task* task = nullptr;
+        std::atomic<int> next { 0 };
+        std::atomic<int> completed { 0 };
+        juce::WaitableEvent done;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        explicit Worker(OfflineRenderPool& p) : juce::Thread("DDX3216 Render Worker"), owner(p) {}
+
+        void run() override
+        {
+            // Same rounding as the forking audio thread, or the tails would
+            // come out differently once they go subnormal
+            juce::ScopedNoDenormals noDenormals;
+
+            while (!threadShouldExit())
+            {
+                wake.wait(idleWaitMs);
+                owner.helpWithForks();
+            }
+        }
+
+        juce::WaitableEvent wake;
+
+    private:
+        static constexpr int idleWaitMs = 100;
+        OfflineRenderPool& owner;
+    };
+
+    Fork* claimFork() noexcept
+    {
+        for (auto& fork : forks)
+        {
+            int expected = Fork::free;
+
+            if (fork.state.compare_exchange_strong(expected, Fork::claimed))
+                return &fork;
+        }
+
+        return nullptr;
+    }
+
+    void releaseFork(Fork& fork) noexcept
+    {
+        fork.state = Fork::finishing;
+
+        // A worker that got in before that is at most finishing its scan
+        while (fork.users.load() != 0)
+            juce::Thread::yield();
+
+        fork.state = Fork::free;
+    }
+
+    void helpWithForks()
+    {
+        for (auto& fork : forks)
+        {
+            ++fork.users;
+
+            if (fork.state.load() == Fork::active)
+                fork.runTasks();
+
+            --fork.users;
+        }
+    }
+
+    // Room for a fork from every task of an outer fork
+    static constexpr int maxForks = 2 * maxTasks;
+
+    std::array<Fork, maxForks> forks;
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderPool)
+};
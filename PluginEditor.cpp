@@ -10,7 +10,7 @@
 DdxReverbAudioProcessorEditor::DdxReverbAudioProcessorEditor(DdxReverbAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
-    setSize(700, 380);
+    setSize(1000, 380);
 
     // Setup controls
     setupControl(decayControl, "decay", "Decay Time");
@@ -18,6 +18,7 @@ DdxReverbAudioProcessorEditor::DdxReverbAudioProcessorEditor(DdxReverbAudioProce
     setupControl(dampingControl, "damping", "Damping");
     setupControl(diffusionControl, "diffusion", "Diffusion");
     setupControl(hicutControl, "hicut", "Hi Cut");
+    setupControl(lowcutControl, "lowcut", "Low Cut");
     setupControl(bassmultControl, "bassmult", "Bass Mult");
     setupControl(wetControl, "wet", "Wet/Dry");
 
@@ -33,19 +34,91 @@ DdxReverbAudioProcessorEditor::DdxReverbAudioProcessorEditor(DdxReverbAudioProce
     simdAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         audioProcessor.getAPVTS(), "simd", simdButton);
 
+    // CPU guard toggle
+    addAndMakeVisible(cpuGuardButton);
+    cpuGuardButton.setButtonText("CPU Guard");
+    cpuGuardAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "cpuguard", cpuGuardButton);
+
+    // Internal-rate toggle (only has an effect at 88.2 kHz and above)
+    addAndMakeVisible(fixedRateButton);
+    fixedRateButton.setButtonText("48k Internal");
+    fixedRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "fixedrate", fixedRateButton);
+
+    // Aux-send mode toggle (100% wet, all input buses summed)
+    addAndMakeVisible(sendModeButton);
+    sendModeButton.setButtonText("Aux Send");
+    sendModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "sendmode", sendModeButton);
+
+    // Quad-engine toggle (engines 2-4 are set up from the host's parameter list)
+    addAndMakeVisible(quadModeButton);
+    quadModeButton.setButtonText("Quad");
+    quadModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "quadmode", quadModeButton);
+
+    // True-stereo toggle
+    addAndMakeVisible(stereoModeButton);
+    stereoModeButton.setButtonText("True Stereo");
+    stereoModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "stereomode", stereoModeButton);
+
+    // Pipelined worker-thread toggle (priority/core are host parameters)
+    addAndMakeVisible(pipelineButton);
+    pipelineButton.setButtonText("Worker Thread");
+    pipelineAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "pipeline", pipelineButton);
+
+    // Out-of-process engine toggle (Linux; needs DDX3216EngineHost next to the plugin)
+    addAndMakeVisible(outOfProcessButton);
+    outOfProcessButton.setButtonText("Out of Process");
+    outOfProcessAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getAPVTS(), "outofprocess", outOfProcessButton);
+
+    // Reverb program (items must be in place before the attachment)
+    addAndMakeVisible(programBox);
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.getAPVTS().getParameter("program")))
+        programBox.addItemList(choice->choices, 1);
+    programAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), "program", programBox);
+
+    // Late-reverb algorithm
+    addAndMakeVisible(algorithmBox);
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.getAPVTS().getParameter("algorithm")))
+        algorithmBox.addItemList(choice->choices, 1);
+    algorithmAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), "algorithm", algorithmBox);
+
+    // Early-reflection pattern (Auto follows the program; off for velvet)
+    addAndMakeVisible(earlyBox);
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.getAPVTS().getParameter("early")))
+        earlyBox.addItemList(choice->choices, 1);
+    earlyAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), "early", earlyBox);
+
+    // Delay modulation (depth and rate are host parameters)
+    addAndMakeVisible(modulationBox);
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.getAPVTS().getParameter("modulation")))
+        modulationBox.addItemList(choice->choices, 1);
+    modulationAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getAPVTS(), "modulation", modulationBox);
+
     // Processing mode label
     addAndMakeVisible(processingModeLabel);
     processingModeLabel.setText("Processing Mode:", juce::dontSendNotification);
     processingModeLabel.setJustificationType(juce::Justification::centredLeft);
     processingModeLabel.setFont(juce::FontOptions(14.0f, juce::Font::bold)); // Fixed: JUCE 8 FontOptions
 
-    // Start timer for CPU monitoring
+    // Start timer for CPU monitoring; the processor only publishes while we listen
+    audioProcessor.setTelemetryEnabled(true);
     startTimerHz(10);
 }
 
 DdxReverbAudioProcessorEditor::~DdxReverbAudioProcessorEditor()
 {
     stopTimer();
+    audioProcessor.setTelemetryEnabled(false);
 }
 
 //==============================================================================
@@ -102,9 +175,51 @@ void DdxReverbAudioProcessorEditor::paint(juce::Graphics& g)
     g.fillRect(footerArea.reduced(10, 5));
 
     // CPU usage meter
-    bool usingSIMD = *audioProcessor.getAPVTS().getRawParameterValue("simd") > 0.5f;
-    juce::String cpuText = juce::String("CPU: ") + juce::String(currentCpuUsage * 100.0f, 1) + "% | Mode: "
-        + (usingSIMD ? "SIMD (Optimized)" : "Scalar (Authentic)");
+    const bool usingSIMD = telemetry.simd;
+    juce::String cpuText = juce::String("CPU: ") + juce::String(telemetry.cpuUsage * 100.0f, 1) + "%";
+
+    if (telemetry.blockSize > 0)
+        cpuText += " @ " + juce::String(telemetry.blockSize) + " / " + juce::String(telemetry.sampleRate / 1000.0, 1) + "k";
+
+    // Extra cost of the second engine while a preset crossfade is running
+    if (telemetry.fadeCpuUsage > 0.0f)
+        cpuText += " (xfade +" + juce::String(telemetry.fadeCpuUsage * 100.0f, 1) + "%)";
+
+    if (telemetry.asleep)
+        cpuText += " (sleeping)";
+
+    // Peak levels in dBFS: network input, wet output, main output
+    auto toDb = [] (float peak) { return juce::String(juce::roundToInt(juce::Decibels::gainToDecibels(peak, -99.0f))); };
+    cpuText += " | In " + toDb(telemetry.inputPeak) + " Wet " + toDb(telemetry.wetPeak) + " Out " + toDb(telemetry.outputPeak) + " dB";
+
+    // Surround layouts: the meter reading is the per-layout cost
+    if (audioProcessor.getMainBusNumOutputChannels() > 2)
+        cpuText += " | " + audioProcessor.getChannelLayoutOfBus(false, 0).getDescription();
+
+    // Network cost per sample, classic algorithm first for comparison
+    const int algorithmIndex = static_cast<int>(telemetry.algorithm);
+
+    if (classicCyclesPerSample > 0.0f)
+        cpuText += " | " + algorithmBox.getItemText(0) + " " + juce::String(juce::roundToInt(classicCyclesPerSample)) + " cyc/smp";
+
+    if (algorithmIndex > 0 && algorithmCyclesPerSample > 0.0f)
+        cpuText += " vs " + algorithmBox.getItemText(algorithmIndex) + " " + juce::String(juce::roundToInt(algorithmCyclesPerSample));
+
+    if (telemetry.remoteOverheadMicroseconds > 0.0f)
+        cpuText += " | Remote +" + juce::String(juce::roundToInt(telemetry.remoteOverheadMicroseconds)) + " us"
+                     + (telemetry.remoteLagging ? " (lagging)" : "");
+
+    if (telemetry.pipelineUnderruns > 0)
+        cpuText += " | Worker late x" + juce::String(telemetry.pipelineUnderruns);
+
+    if (telemetry.qualityTier > 0)
+        cpuText += " | Guard tier " + juce::String(telemetry.qualityTier);
+
+    cpuText += juce::String(" | Mode: ") + (usingSIMD ? "SIMD (Optimized)" : "Scalar (Authentic)");
+
+    if (telemetry.doublePrecision || telemetry.wideAccumulation)
+        cpuText += juce::String(" | ") + (telemetry.doublePrecision ? "64-bit I/O" : "32-bit I/O")
+                 + (telemetry.wideAccumulation ? ", double acc" : "");
 
     g.setColour(usingSIMD ? juce::Colours::lightgreen : juce::Colours::orange);
     g.setFont(juce::FontOptions(13.0f, juce::Font::bold)); // Fixed: FontOptions
@@ -143,6 +258,9 @@ void DdxReverbAudioProcessorEditor::resized()
     hicutControl.slider.setBounds(controlArea.removeFromLeft(sliderWidth));
     controlArea.removeFromLeft(spacing);
 
+    lowcutControl.slider.setBounds(controlArea.removeFromLeft(sliderWidth));
+    controlArea.removeFromLeft(spacing);
+
     bassmultControl.slider.setBounds(controlArea.removeFromLeft(sliderWidth));
     controlArea.removeFromLeft(spacing * 3);
 
@@ -152,18 +270,49 @@ void DdxReverbAudioProcessorEditor::resized()
     // Footer controls
     auto footerArea = bounds.removeFromTop(80).reduced(20, 10);
 
-    processingModeLabel.setBounds(footerArea.removeFromTop(25));
+    auto labelArea = footerArea.removeFromTop(25);
+    processingModeLabel.setBounds(labelArea.removeFromLeft(150));
+    programBox.setBounds(labelArea.removeFromLeft(110).reduced(0, 1));
+    labelArea.removeFromLeft(10);
+    algorithmBox.setBounds(labelArea.removeFromLeft(160).reduced(0, 1));
+    labelArea.removeFromLeft(10);
+    earlyBox.setBounds(labelArea.removeFromLeft(110).reduced(0, 1));
+    labelArea.removeFromLeft(10);
+    modulationBox.setBounds(labelArea.removeFromLeft(100).reduced(0, 1));
+    labelArea.removeFromLeft(10);
+    pipelineButton.setBounds(labelArea.removeFromLeft(120));
+    labelArea.removeFromLeft(10);
+    outOfProcessButton.setBounds(labelArea.removeFromLeft(140));
 
     auto buttonArea = footerArea.removeFromTop(30);
     bypassButton.setBounds(buttonArea.removeFromLeft(120));
     buttonArea.removeFromLeft(20);
-    simdButton.setBounds(buttonArea.removeFromLeft(200));
+    simdButton.setBounds(buttonArea.removeFromLeft(170));
+    buttonArea.removeFromLeft(20);
+    cpuGuardButton.setBounds(buttonArea.removeFromLeft(120));
+    buttonArea.removeFromLeft(20);
+    fixedRateButton.setBounds(buttonArea.removeFromLeft(130));
+    buttonArea.removeFromLeft(20);
+    sendModeButton.setBounds(buttonArea.removeFromLeft(110));
+    buttonArea.removeFromLeft(20);
+    quadModeButton.setBounds(buttonArea.removeFromLeft(80));
+    buttonArea.removeFromLeft(20);
+    stereoModeButton.setBounds(buttonArea.removeFromLeft(110));
 }
 
 //==============================================================================
 void DdxReverbAudioProcessorEditor::timerCallback()
 {
-    // Update CPU usage display
-    currentCpuUsage = audioProcessor.getCpuUsage();
+    // Update CPU usage display from the latest whole snapshot
+    telemetry = audioProcessor.readTelemetry();
+    classicCyclesPerSample = audioProcessor.getNetworkCyclesPerSample(ReverbAlgorithm::sharc);
+    algorithmCyclesPerSample = audioProcessor.getNetworkCyclesPerSample(telemetry.algorithm);
+
+    // The lane-packed modes only follow the program; grey out what they ignore
+    const bool laneMode = audioProcessor.isLaneModeActive();
+    algorithmBox.setEnabled(!laneMode);
+    earlyBox.setEnabled(!laneMode);
+    modulationBox.setEnabled(!laneMode);
+    bassmultControl.slider.setEnabled(!laneMode);
     repaint(0, getHeight() - 95, getWidth(), 95); // Only repaint footer
 }
\ No newline at end of file
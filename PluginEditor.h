@@ -35,18 +35,43 @@ private:
     ControlGroup dampingControl;
     ControlGroup diffusionControl;
     ControlGroup hicutControl;
+    ControlGroup lowcutControl;
     ControlGroup bassmultControl;
     ControlGroup wetControl;
 
     juce::ToggleButton bypassButton;
     juce::ToggleButton simdButton;
+    juce::ToggleButton cpuGuardButton;
+    juce::ToggleButton fixedRateButton;
+    juce::ToggleButton sendModeButton;
+    juce::ToggleButton quadModeButton;
+    juce::ToggleButton stereoModeButton;
+    juce::ToggleButton pipelineButton;
+    juce::ToggleButton outOfProcessButton;
     juce::Label processingModeLabel;
+    juce::ComboBox programBox;
+    juce::ComboBox algorithmBox;
+    juce::ComboBox earlyBox;
+    juce::ComboBox modulationBox;
 
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> simdAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> cpuGuardAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> fixedRateAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> sendModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> quadModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> stereoModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> pipelineAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> outOfProcessAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> programAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> algorithmAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> earlyAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modulationAttachment;
 
-    // CPU meter
-    float currentCpuUsage = 0.0f;
+    // CPU meter - latest audio-thread snapshot
+    DdxReverbAudioProcessor::Telemetry telemetry;
+    float classicCyclesPerSample = 0.0f;
+    float algorithmCyclesPerSample = 0.0f;
 
     void setupControl(ControlGroup& control, const juce::String& paramID, const juce::String& labelText);
 
@@ -5,289 +5,2203 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "RealtimeWake.h"
 
-// Prime-number delays (scaled for 48kHz, typical in SHARC reverbs)
-const int DdxReverbAudioProcessor::combDelays[numCombs] = { 1116, 1188, 1277, 1356 };
-const int DdxReverbAudioProcessor::allpassDelays[numAllpasses] = { 556, 441, 313, 391, 347, 113, 37, 59 };
+//==============================================================================
+// Binary state blob (all fields little-endian, fixed layout):
+//   uint32 magic "DDXR" | uint16 version | uint16 numValues | float values[numValues]
+// Values are stored in stateParameterIDs order. New parameters are only ever
+// appended, so older blobs simply leave the newer parameters at their defaults.
+//==============================================================================
+namespace
+{
+    constexpr juce::uint32 stateMagic = 0x52584444; // 'D' 'D' 'X' 'R'
+    constexpr juce::uint16 stateVersion = 1;
+    constexpr int stateHeaderSize = 8;
+
+    // Names the APVTS gives its parameter nodes
+    const juce::Identifier parameterNodeType { "PARAM" };
+    const juce::Identifier parameterIdProperty { "id" };
+    const juce::Identifier parameterValueProperty { "value" };
+
+    const char* const stateParameterIDs[] =
+    {
+        "decay", "predelay", "damping", "diffusion", "hicut", "bassmult", "wet",
+        "bypass", "simd", "xfade", "lowcut", "cpuguard", "cpubudget",
+        "fixedrate", "sendmode", "quadmode",
+        "decay2", "predelay2", "damping2", "diffusion2", "hicut2", "lowcut2", "wet2",
+        "decay3", "predelay3", "damping3", "diffusion3", "hicut3", "lowcut3", "wet3",
+        "decay4", "predelay4", "damping4", "diffusion4", "hicut4", "lowcut4", "wet4",
+        "stereomode", "algorithm", "pipeline", "workerpriority", "workercore",
+        "outofprocess", "early", "program", "wideaccum",
+        "modulation", "moddepth", "modrate"
+    };
+
+    // A state from before one of these existed sounded like this value, not
+    // like the new parameter's default (plain values, not 0..1)
+    struct LegacyValue
+    {
+        const char* id;
+        float value;
+    };
+
+    const LegacyValue legacyParameterValues[] =
+    {
+        { "early", 1.0f } // Off - older versions had no early reflections
+    };
+
+    // Quad mode: engine 1 uses the main controls, engines 2-4 their own copies
+    const char* const quadParameterIDs[][7] =
+    {
+        { "decay", "predelay", "damping", "diffusion", "hicut", "lowcut", "wet" },
+        { "decay2", "predelay2", "damping2", "diffusion2", "hicut2", "lowcut2", "wet2" },
+        { "decay3", "predelay3", "damping3", "diffusion3", "hicut3", "lowcut3", "wet3" },
+        { "decay4", "predelay4", "damping4", "diffusion4", "hicut4", "lowcut4", "wet4" }
+    };
+
+    void writeLittleEndian(char* dest, juce::uint32 value) noexcept
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(dest, &value, sizeof(value));
+    }
+
+    void writeLittleEndian(char* dest, juce::uint16 value) noexcept
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(dest, &value, sizeof(value));
+    }
+}
+
+//==============================================================================
+// Background thread that builds replacement engines and frees retired ones,
+// so neither allocation nor deallocation of delay memory hits the audio thread
+//==============================================================================
+class DdxReverbAudioProcessor::EngineBuilder : public juce::Thread,
+                                               private juce::Thread::Listener
+{
+public:
+    explicit EngineBuilder(DdxReverbAudioProcessor& p)
+        : juce::Thread("DDX3216 Engine Builder"), owner(p)
+    {
+        addListener(this);
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~EngineBuilder() override
+    {
+        stopThread(2000);
+        removeListener(this);
+    }
+
+    // Sets the spec every engine should match. With rebuildActive the
+    // running engine is replaced; the spare engine is always kept in step.
+    // Replacements carry the generation they were requested as.
+    void setTargetSpec(const ReverbEngineSpec& spec, juce::uint32 generation, bool rebuildActive)
+    {
+        {
+            const juce::SpinLock::ScopedLockType lock(specLock);
+            targetSpec = spec;
+            targetGeneration = generation;
+            hasTargetSpec = true;
+            buildRequested = buildRequested || rebuildActive;
+        }
+
+        wake.signal();
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            ReverbEngineSpec spec;
+            juce::uint32 generation = 0;
+            bool shouldBuild = false;
+            bool haveSpec = false;
+
+            {
+                const juce::SpinLock::ScopedLockType lock(specLock);
+                std::swap(shouldBuild, buildRequested);
+                spec = targetSpec;
+                generation = targetGeneration;
+                haveSpec = hasTargetSpec;
+            }
+
+            // The audio thread never signals us, so poll for retired engines
+            if (auto* retired = owner.retiredEngine.exchange(nullptr))
+                recycleOrFree(retired, spec);
+
+            if (shouldBuild)
+            {
+                auto engine = std::make_unique<DdxReverbEngine>();
+                engine->prepare(spec);
+                engine->setGeneration(generation);
+
+                // Replaces any engine the audio thread has not picked up yet
+                delete owner.pendingEngine.exchange(engine.release());
+            }
+
+            if (haveSpec)
+                refreshSpare(spec);
+
+            wake.wait(retirePollMs);
+        }
+    }
+
+private:
+    void exitSignalSent() override { wake.signal(); }
+
+    // An engine coming back from a preset crossfade still matches the target
+    // spec, so clear it and keep it as the next spare instead of freeing it
+    void recycleOrFree(DdxReverbEngine* engine, const ReverbEngineSpec& spec)
+    {
+        if (engine->getSpec() == spec && owner.spareEngine.load() == nullptr)
+        {
+            engine->reset();
+
+            DdxReverbEngine* expected = nullptr;
+            if (owner.spareEngine.compare_exchange_strong(expected, engine))
+                return;
+        }
+
+        delete engine;
+    }
+
+    void refreshSpare(const ReverbEngineSpec& spec)
+    {
+        auto* spare = owner.spareEngine.load();
+
+        if (spare != nullptr && spare->getSpec() != spec)
+            if (owner.spareEngine.compare_exchange_strong(spare, nullptr))
+                delete spare;
+
+        // While a preset fade runs, the outgoing engine comes back as the spare
+        if (owner.spareEngine.load() != nullptr || owner.presetFadeActive.load())
+            return;
+
+        auto engine = std::make_unique<DdxReverbEngine>();
+        engine->prepare(spec);
+
+        DdxReverbEngine* expected = nullptr;
+        if (owner.spareEngine.compare_exchange_strong(expected, engine.get()))
+            engine.release();
+    }
+
+    static constexpr int retirePollMs = 50;
+
+    DdxReverbAudioProcessor& owner;
+    RealtimeWake wake;
+    juce::SpinLock specLock;
+    ReverbEngineSpec targetSpec;
+    juce::uint32 targetGeneration = 0;
+    bool hasTargetSpec = false;
+    bool buildRequested = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineBuilder)
+};
+
+//==============================================================================
+// Realtime worker for the pipelined mode. The audio thread pushes each
+// captured input block and pulls back wet audio one block later; samples
+// cross between the threads through single-producer/single-consumer rings,
+// so neither side ever waits on the other.
+//==============================================================================
+class DdxReverbAudioProcessor::PipelineWorker : public juce::Thread,
+                                                private juce::Thread::Listener
+{
+public:
+    explicit PipelineWorker(DdxReverbAudioProcessor& p)
+        : juce::Thread("DDX3216 Pipeline Worker"), owner(p)
+    {
+        addListener(this);
+    }
+
+    ~PipelineWorker() override
+    {
+        stopThread(2000);
+        removeListener(this);
+    }
+
+    // Sizes the rings and records where the thread runs. Audio must not be
+    // running. core is 1-based (0 = let the OS choose); priority is 0-10.
+    // A worker still running is first left to finish what it was given, so
+    // the caller may touch the engine once this returns. The thread only
+    // runs while shouldRun is set; with the same settings a running one is
+    // left alone.
+    void prepare(double sampleRate, int maxBlockSize, int priority, int core, bool shouldRun)
+    {
+        drain();
+
+        const bool sameSettings = maxBlockSize == blockSize && sampleRate == preparedSampleRate
+                                  && priority == preparedPriority && core == preparedCore;
+
+        if (!sameSettings || !shouldRun)
+            stopThread(2000);
+
+        if (maxBlockSize != blockSize)
+        {
+            blockSize = maxBlockSize;
+            const int capacity = ringBlocks * maxBlockSize;
+
+            inputFifo.setTotalSize(capacity + 1);
+            outputFifo.setTotalSize(capacity + 1);
+            inputRing.assign(static_cast<size_t>(capacity + 1), 0.0f);
+            outputRing.assign(static_cast<size_t>(capacity + 1), 0.0f);
+            workBuffer.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+        }
+
+        preparedSampleRate = sampleRate;
+        preparedPriority = priority;
+        preparedCore = core;
+
+        if (shouldRun)
+            launch();
+    }
+
+    // Message thread or prepare: starts the thread with the prepared
+    // placement, unless it is already running (or nothing is prepared yet)
+    void launch()
+    {
+        if (isThreadRunning() || blockSize == 0)
+            return;
+
+        setAffinityMask(juce::isPositiveAndBelow(preparedCore - 1, 32) ? (juce::uint32 { 1 } << (preparedCore - 1)) : 0);
+
+        const auto options = juce::Thread::RealtimeOptions {}
+                                 .withPriority(juce::jlimit(0, 10, preparedPriority))
+                                 .withApproximateAudioProcessingTime(blockSize, preparedSampleRate);
+
+        if (!startRealtimeThread(options))
+            startThread(juce::Thread::Priority::highest);
+    }
+
+    // One host block: what the audio thread has to delay the dry path by
+    int getLatencySamples() const noexcept { return blockSize; }
+
+    // Audio thread: true once the worker has nothing queued or in flight,
+    // so the network can be handed back
+    bool isIdle() const noexcept
+    {
+        return !processing.load() && inputFifo.getNumReady() == 0;
+    }
+
+    // Audio thread, worker idle: drop leftovers and start a fresh block of delay
+    void start() noexcept
+    {
+        outputFifo.read(outputFifo.getNumReady());
+        primeRemaining = blockSize;
+    }
+
+    // Audio thread
+    void push(const float* data, int numSamples) noexcept
+    {
+        const auto scope = inputFifo.write(juce::jmin(numSamples, inputFifo.getFreeSpace()));
+        copyIn(inputRing, scope, data);
+        wake.signal();
+    }
+
+    // Audio thread: wet audio one block behind; anything the worker has not
+    // delivered yet comes out as silence and counts as an underrun
+    void pull(float* data, int numSamples) noexcept
+    {
+        const int numPrimed = juce::jmin(primeRemaining, numSamples);
+        juce::FloatVectorOperations::clear(data, numPrimed);
+        primeRemaining -= numPrimed;
+
+        const auto scope = outputFifo.read(numSamples - numPrimed);
+        copyOut(outputRing, scope, data + numPrimed);
+
+        const int numDelivered = numPrimed + scope.blockSize1 + scope.blockSize2;
+
+        if (numDelivered < numSamples)
+        {
+            juce::FloatVectorOperations::clear(data + numDelivered, numSamples - numDelivered);
+            underruns.fetch_add(1);
+        }
+    }
+
+    int getNumUnderruns() const noexcept { return underruns.load(); }
+
+    void run() override
+    {
+        // The network runs here, not under processBlock's flag. A pipeline never
+        // sleeps, so every tail would otherwise decay into denormals.
+        juce::ScopedNoDenormals noDenormals;
+
+        while (!threadShouldExit())
+        {
+            wake.wait(idleWaitMs);
+
+            // Raised before looking at the ring, so isIdle() never sees an
+            // empty ring while a block is about to be taken
+            processing = true;
+
+            while (!threadShouldExit() && inputFifo.getNumReady() > 0)
+            {
+                auto* work = workBuffer.data();
+
+                const int numSamples = [&]
+                {
+                    const auto scope = inputFifo.read(juce::jmin(blockSize, inputFifo.getNumReady()));
+                    copyOut(inputRing, scope, work);
+                    return scope.blockSize1 + scope.blockSize2;
+                }();
+
+                owner.processPipelinedBlock(work, numSamples);
+
+                const auto scope = outputFifo.write(juce::jmin(numSamples, outputFifo.getFreeSpace()));
+                copyIn(outputRing, scope, work);
+            }
+
+            processing = false;
+        }
+    }
+
+private:
+    void exitSignalSent() override { wake.signal(); }
+
+    // Waits for a running worker to go idle, then drops everything queued
+    // either way, so no late output ends up behind the next prime
+    void drain() noexcept
+    {
+        while (isThreadRunning() && !isIdle())
+            juce::Thread::yield();
+
+        inputFifo.reset();
+        outputFifo.reset();
+        primeRemaining = 0;
+    }
+
+    static void copyIn(std::vector<float>& ring, const juce::AbstractFifo::ScopedWrite& scope, const float* src) noexcept
+    {
+        if (scope.blockSize1 > 0)
+            juce::FloatVectorOperations::copy(ring.data() + scope.startIndex1, src, scope.blockSize1);
+
+        if (scope.blockSize2 > 0)
+            juce::FloatVectorOperations::copy(ring.data() + scope.startIndex2, src + scope.blockSize1, scope.blockSize2);
+    }
+
+    static void copyOut(const std::vector<float>& ring, const juce::AbstractFifo::ScopedRead& scope, float* dest) noexcept
+    {
+        if (scope.blockSize1 > 0)
+            juce::FloatVectorOperations::copy(dest, ring.data() + scope.startIndex1, scope.blockSize1);
+
+        if (scope.blockSize2 > 0)
+            juce::FloatVectorOperations::copy(dest + scope.blockSize1, ring.data() + scope.startIndex2, scope.blockSize2);
+    }
+
+    static constexpr int ringBlocks = 4;
+    static constexpr int idleWaitMs = 100;
+
+    DdxReverbAudioProcessor& owner;
+    RealtimeWake wake;
+
+    juce::AbstractFifo inputFifo { 1 };
+    juce::AbstractFifo outputFifo { 1 };
+    std::vector<float> inputRing;
+    std::vector<float> outputRing;
+    std::vector<float> workBuffer;
+
+    int blockSize = 0;
+    double preparedSampleRate = 0.0;
+    int preparedPriority = -1;
+    int preparedCore = -1;
+    int primeRemaining = 0; // audio thread only
+    std::atomic<bool> processing { false };
+    std::atomic<int> underruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PipelineWorker)
+};
+
+//==============================================================================
+// Plugin end of the out-of-process engine: owns the shared segment and the
+// engine process. launch/stop on the message thread, process on the audio
+// thread - the processor keeps the two apart with remoteReady/remoteInUse.
+//==============================================================================
+class DdxReverbAudioProcessor::RemoteEngineClient
+{
+public:
+    ~RemoteEngineClient()
+    {
+        stop();
+    }
+
+    bool launch(const juce::File& executable, double newSampleRate, int newMaxBlockSize, int numParameters)
+    {
+        stop();
+
+        if (!executable.existsAsFile()
+            || !ring.create("/ddx3216-" + juce::Uuid().toDashedString(), newSampleRate, newMaxBlockSize, numParameters))
+            return false;
+
+        if (!engineProcess.start(juce::StringArray { executable.getFullPathName(), "--engine", ring.getName() }, 0)
+            || !ring.waitForEngineState(SharedAudioRing::ready, launchTimeoutMs))
+        {
+            stop();
+            return false;
+        }
+
+        sampleRate = newSampleRate;
+        maxBlockSize = newMaxBlockSize;
+        lagging = false;
+        consecutiveLags = 0;
+        return true;
+    }
+
+    void stop()
+    {
+        if (!ring.isOpen())
+            return;
+
+        ring.setEngineState(SharedAudioRing::shutdown);
+
+        if (engineProcess.isRunning() && !engineProcess.waitForProcessToFinish(shutdownTimeoutMs))
+            engineProcess.kill();
+
+        ring.close();
+    }
+
+    bool matches(double otherSampleRate, int otherMaxBlockSize) const noexcept
+    {
+        return ring.isOpen() && sampleRate == otherSampleRate && maxBlockSize == otherMaxBlockSize;
+    }
+
+    enum class Result
+    {
+        processed, // the block came back from the engine
+        lagging,   // the engine is late - process this block here, try again next block
+        failed     // hung, gone or late block after block - relaunch it
+    };
+
+    // Audio thread: the main stereo pair goes out through the next slot and
+    // comes back processed
+    Result process(juce::AudioBuffer<float>& buffer, int numSamples, const std::vector<std::atomic<float>*>& values) noexcept
+    {
+        if (numSamples > maxBlockSize)
+            return Result::failed;
+
+        // Nothing more is queued behind a late block, so the slot it is
+        // still working on is never overwritten
+        if (lagging)
+        {
+            if (!ring.hasEngineCaughtUp())
+            {
+                const double lagMicroseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - lagStart) * 1.0e6;
+                return lagMicroseconds < hangTimeoutMicroseconds ? Result::lagging : Result::failed;
+            }
+
+            lagging = false;
+        }
+
+        const auto sequence = ring.getHeader().head.load(std::memory_order_relaxed);
+        auto& slot = ring.getSlot(sequence);
+
+        slot.numSamples = numSamples;
+
+        for (size_t i = 0; i < values.size(); ++i)
+            slot.parameters[i] = values[i]->load();
+
+        for (int channel = 0; channel < SharedAudioRing::numChannels; ++channel)
+            juce::FloatVectorOperations::copy(ring.getSlotChannel(sequence, channel),
+                                              buffer.getReadPointer(juce::jmin(channel, buffer.getNumChannels() - 1)), numSamples);
+
+        // Only part of the block period, so a late engine still leaves time
+        // to process the block here before the host's deadline
+        const double timeoutMicroseconds = waitFraction * 1.0e6 * numSamples / sampleRate;
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        ring.submit();
+
+        if (!ring.waitForEngine(timeoutMicroseconds, spinMicroseconds))
+        {
+            lagging = true;
+            lagStart = start;
+            return ++consecutiveLags < maxConsecutiveLags ? Result::lagging : Result::failed;
+        }
+
+        consecutiveLags = 0;
+
+        const double roundTrip = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+        overheadMicroseconds = static_cast<float>(roundTrip) - slot.engineMicroseconds;
+
+        for (int channel = 0; channel < juce::jmin(buffer.getNumChannels(), SharedAudioRing::numChannels); ++channel)
+            buffer.copyFrom(channel, 0, ring.getSlotChannel(sequence, channel), numSamples);
+
+        return Result::processed;
+    }
+
+    // Round trip minus the engine's own processing time, last block
+    float getOverheadMicroseconds() const noexcept { return overheadMicroseconds; }
+
+private:
+    static constexpr int launchTimeoutMs = 2000;
+    static constexpr int shutdownTimeoutMs = 1000;
+    static constexpr double waitFraction = 0.25;
+
+    // An engine still busy with a late block after this long is taken as hung,
+    // and one that misses this many deadlines in a row as too slow to keep
+    static constexpr double hangTimeoutMicroseconds = 250000.0;
+    static constexpr int maxConsecutiveLags = 8;
+
+    // Most blocks come back within this, so the futex sleep is rarely needed
+    static constexpr double spinMicroseconds = 50.0;
+
+    SharedAudioRing ring;
+    juce::ChildProcess engineProcess;
+    double sampleRate = 48000.0;
+    int maxBlockSize = 0;
+    float overheadMicroseconds = 0.0f; // audio thread only
+
+    // Audio thread only (and launch, while the audio thread is kept out)
+    bool lagging = false;
+    juce::int64 lagStart = 0;
+    int consecutiveLags = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteEngineClient)
+};
 
 //==============================================================================
 DdxReverbAudioProcessor::DdxReverbAudioProcessor()
     : AudioProcessor(BusesProperties()
         .withInput("Input", juce::AudioChannelSet::stereo(), true)
-        .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+        .withInput("Send 2", juce::AudioChannelSet::stereo(), false)
+        .withInput("Send 3", juce::AudioChannelSet::stereo(), false)
+        .withInput("Send 4", juce::AudioChannelSet::stereo(), false)
+        .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+        .withOutput("Output 2", juce::AudioChannelSet::stereo(), false)
+        .withOutput("Output 3", juce::AudioChannelSet::stereo(), false)
+        .withOutput("Output 4", juce::AudioChannelSet::stereo(), false)),
     apvts(*this, nullptr, "PARAMS", createParameterLayout())
 {
+    auto constructionStart = juce::Time::getMillisecondCounterHiRes();
+
+    // Resolve the state parameters once so save/load skips the ID lookups
+    for (auto* id : stateParameterIDs)
+    {
+        stateParameters.push_back(apvts.getParameter(id));
+        stateValues.push_back(apvts.getRawParameterValue(id));
+    }
+
+    for (int engine = 0; engine < numQuadEngines; ++engine)
+    {
+        auto& values = quadParameters[static_cast<size_t>(engine)];
+        const auto* ids = quadParameterIDs[engine];
+
+        values.decay = apvts.getRawParameterValue(ids[0]);
+        values.predelay = apvts.getRawParameterValue(ids[1]);
+        values.damping = apvts.getRawParameterValue(ids[2]);
+        values.diffusion = apvts.getRawParameterValue(ids[3]);
+        values.hicut = apvts.getRawParameterValue(ids[4]);
+        values.lowcut = apvts.getRawParameterValue(ids[5]);
+        values.wet = apvts.getRawParameterValue(ids[6]);
+    }
+
+    engineBuilder = std::make_unique<EngineBuilder>(*this);
+    pipelineWorker = std::make_unique<PipelineWorker>(*this);
+    remoteEngine = std::make_unique<RemoteEngineClient>();
+
+    cpuSpeedMHz = juce::SystemStats::getCpuSpeedInMegahertz();
+
+    constructionTimeMs = juce::Time::getMillisecondCounterHiRes() - constructionStart;
+}
+
+DdxReverbAudioProcessor::~DdxReverbAudioProcessor()
+{
+    cancelPendingUpdate();
+
+    // Shuts the engine process down and unlinks the segment
+    remoteEngine.reset();
+
+    // The worker may still be running the network
+    pipelineWorker.reset();
+    offlinePool.reset();
+
+    // Stop the builder first so nothing else touches the hand-off slots
+    engineBuilder.reset();
+
+    delete pendingEngine.exchange(nullptr);
+    delete retiredEngine.exchange(nullptr);
+    delete spareEngine.exchange(nullptr);
+}
+
+//==============================================================================
+juce::AudioProcessorValueTreeState::ParameterLayout DdxReverbAudioProcessor::createParameterLayout()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+
+    // The low-cut's bottom end switches it off
+    const auto lowCutRange = juce::NormalisableRange<float>(InputFilterBank::lowCutOffHz, 500.0f, 1.0f, 0.4f);
+    const auto lowCutAttributes = juce::AudioParameterFloatAttributes()
+                                      .withLabel("Hz")
+                                      .withStringFromValueFunction([](float value, int)
+                                      {
+                                          return value <= InputFilterBank::lowCutOffHz ? juce::String("Off")
+                                                                                       : juce::String(juce::roundToInt(value));
+                                      });
+
+    // DDX3216 Cathedral parameters (based on SysEx spec)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "decay", "Decay Time",
+        juce::NormalisableRange<float>(2.0f, 20.0f, 0.1f), 5.0f, "s"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "predelay", "Pre-Delay",
+        juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f), 50.0f, "ms"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "damping", "Damping (Hi Decay)",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 50.0f, "%"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "diffusion", "Diffusion",
+        juce::NormalisableRange<float>(0.0f, 20.0f, 0.1f), 10.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "hicut", "Hi Shelf Cut",
+        juce::NormalisableRange<float>(0.0f, 30.0f, 0.1f), 0.0f, "dB"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "lowcut", "Low Cut", lowCutRange, InputFilterBank::lowCutOffHz, lowCutAttributes));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "bassmult", "Bass Multiply",
+        juce::NormalisableRange<float>(-10.0f, 10.0f, 0.1f), 0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "wet", "Wet/Dry Mix",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "xfade", "Preset Crossfade",
+        juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f), 100.0f, "ms"));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "bypass", "Bypass", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "simd", "Use SIMD (Low CPU)", false));
+
+    // Comb sum and all-pass chain in double (delay memory stays float).
+    // Costs the SIMD path; mainly for 64-bit hosts and null tests.
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "wideaccum", "Double Accumulators", false));
+
+    // CPU guard: step down through quality tiers when the load exceeds the budget
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "cpuguard", "CPU Guard", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "cpubudget", "CPU Budget",
+        juce::NormalisableRange<float>(10.0f, 100.0f, 1.0f), 70.0f, "%"));
+
+    // Run the network at 44.1/48 kHz when the host is at 88.2 kHz or above
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "fixedrate", "48k Internal Rate", false));
+
+    // Aux-send mode: every enabled input bus feeds the network, output is 100% wet
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "sendmode", "Aux Send Mode", false));
+
+    // Quad mode: four independent reverbs, one per stereo bus pair, in one SIMD pass
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "quadmode", "Quad Engine Mode", false));
+
+    // True stereo: separate L/R networks in adjacent SIMD lanes instead of
+    // the mono network with an inverted right channel
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "stereomode", "True Stereo", false));
+
+    // Late-reverb stage of the mono network: the DDX3216 combs, an FDN, or
+    // velvet noise for cheap monitor/preview use. Choices are only appended.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "algorithm", "Algorithm", juce::StringArray { "SHARC Combs", "FDN 4x4", "FDN 8x8", "Velvet (Low CPU)" }, 0));
+
+    // DDX3216 reverb program: delay tables and early/late mix of the mono
+    // network. Choices follow ReverbProgram and are only appended.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "program", "Program", juce::StringArray { "Cathedral", "Hall", "Room", "Plate", "Ambience", "Gated" }, 0));
+
+    // Early reflections ahead of the late stage; Auto takes the program's
+    // own pattern. Choices after Auto follow EarlyPattern and are only appended.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "early", "Early Reflections", juce::StringArray { "Auto", "Off", "Cathedral", "Hall", "Room" }, 0));
+
+    // Slow LFOs on two combs and the two longest all-passes, read with
+    // fractional interpolation. Choices follow DelayModulation.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "modulation", "Delay Modulation", juce::StringArray { "Off", "Linear", "Lagrange" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "moddepth", "Modulation Depth",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 50.0f, "%"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "modrate", "Modulation Rate",
+        juce::NormalisableRange<float>(0.1f, 2.0f, 0.01f), 0.5f, "Hz"));
+
+    // Pipelined mode: the mono network runs on a realtime worker one block
+    // behind, so the host's audio thread only captures input and mixes.
+    // Priority (0-10) and core (1-based, 0 = any) apply at the next prepare.
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "pipeline", "Worker Thread", false));
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        "workerpriority", "Worker Priority", 0, 10, 8));
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        "workercore", "Worker Core", 0, 32, 0));
+
+    // Out-of-process mode (Linux): the main stereo bus is processed by a
+    // separate engine process, so a crash elsewhere in the host can't take
+    // the reverb down. Falls back to in-process if the engine is missing.
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "outofprocess", "Out-of-Process Engine", false));
+
+    for (int engine = 2; engine <= numQuadEngines; ++engine)
+    {
+        const juce::String suffix(engine);
+        const juce::String name = " " + suffix;
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "decay" + suffix, "Decay Time" + name,
+            juce::NormalisableRange<float>(2.0f, 20.0f, 0.1f), 5.0f, "s"));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "predelay" + suffix, "Pre-Delay" + name,
+            juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f), 50.0f, "ms"));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "damping" + suffix, "Damping (Hi Decay)" + name,
+            juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 50.0f, "%"));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "diffusion" + suffix, "Diffusion" + name,
+            juce::NormalisableRange<float>(0.0f, 20.0f, 0.1f), 10.0f));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "hicut" + suffix, "Hi Shelf Cut" + name,
+            juce::NormalisableRange<float>(0.0f, 30.0f, 0.1f), 0.0f, "dB"));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "lowcut" + suffix, "Low Cut" + name, lowCutRange, InputFilterBank::lowCutOffHz, lowCutAttributes));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            "wet" + suffix, "Wet/Dry Mix" + name,
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+    }
+
+    return { params.begin(), params.end() };
+}
+
+//==============================================================================
+void DdxReverbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    auto prepareStart = juce::Time::getMillisecondCounterHiRes();
+
+    // The engine spec carries the network's own rate, which is below the
+    // host rate when the internal-rate mode is on
+    internalRateApplied = *apvts.getRawParameterValue("fixedrate") > 0.5f;
+    const int factor = internalRateApplied ? PolyphaseResampler::getFactorFor(sampleRate) : 1;
+    const ReverbEngineSpec spec { sampleRate / factor, samplesPerBlock };
+
+    // Before anything below touches the engine: the worker finishes what it
+    // still has and is restarted with the current placement. Unchanged
+    // settings leave it running, so a transport start costs nothing here.
+    // Without the pipeline mode there is no worker thread at all.
+    pipelineWorker->prepare(sampleRate, samplesPerBlock,
+                            juce::roundToInt(apvts.getRawParameterValue("workerpriority")->load()),
+                            juce::roundToInt(apvts.getRawParameterValue("workercore")->load()),
+                            isPipelineRequested());
+
+    setLatencySamples(getReportedLatency(factor));
+
+    remoteApplied = isRemoteRequested();
+    updateRemoteEngine(sampleRate, samplesPerBlock);
+
+    // Many hosts re-prepare on every transport start or bounce with the same
+    // settings - there is nothing to do in that case
+    if (activeEngine != nullptr && spec == targetEngineSpec && sampleRate == currentSampleRate
+        && isUsingDoublePrecision() == (dryBufferDouble.getNumChannels() > 0))
+    {
+        pipelineApplied = isPipelineRequested();
+        if (pipelineApplied)
+            pipelineWorker->start();
+
+        lastPrepareTimeMs = juce::Time::getMillisecondCounterHiRes() - prepareStart;
+        return;
+    }
+
+    currentSampleRate = sampleRate;
+    inputFilters.prepare(sampleRate);
+
+    tailTracker.prepare(sampleRate);
+
+    // Allocate buffers
+    dryBuffer.setSize(2, samplesPerBlock, false, false, true);
+    tempBuffer.setSize(1, samplesPerBlock, false, false, true);
+    fadeBuffer.setSize(1, samplesPerBlock, false, false, true);
+    internalBuffer.setSize(static_cast<int>(wetResamplers.size()), samplesPerBlock, false, false, true);
+
+    remoteFadeBuffer.setSize(2, samplesPerBlock, false, false, true);
+    localFadeBuffer.setSize(2, samplesPerBlock, false, false, true);
+    remoteFadeSamples = 0;
+
+    dryDelayBuffer.setSize(2, PolyphaseResampler::maxLatency + samplesPerBlock + 1, false, true, true);
+    dryDelayBuffer.clear();
+    dryDelayWritePos = 0;
+
+    // Only a double-precision host needs the wide dry path
+    const bool doublePrecision = isUsingDoublePrecision();
+    const int numBlockChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    dryBufferDouble.setSize(doublePrecision ? 2 : 0, samplesPerBlock, false, false, true);
+    dryDelayBufferDouble.setSize(doublePrecision ? 2 : 0, PolyphaseResampler::maxLatency + samplesPerBlock + 1, false, true, true);
+    dryDelayBufferDouble.clear();
+    networkInputBuffer.setSize(doublePrecision ? 2 : 0, samplesPerBlock, false, false, true);
+    precisionBuffer.setSize(doublePrecision ? numBlockChannels : 0, samplesPerBlock, false, false, true);
+
+    // The lane modes run at host rate in lane-packed networks
+    for (auto& network : laneNetworks)
+        network.prepare(sampleRate);
+
+    laneBuffer.setSize(numLaneNetworks * LaneReverbNetwork::maxLanes, samplesPerBlock, false, false, true);
+    quadFilters.prepare(sampleRate);
+    quadDryBuffer.setSize(2 * numQuadEngines, samplesPerBlock, false, false, true);
+
+    networkModeApplied = getNetworkMode(*apvts.getRawParameterValue("quadmode") > 0.5f,
+                                        *apvts.getRawParameterValue("stereomode") > 0.5f);
+    setupLaneNetworks(networkModeApplied);
+
+    if (activeEngine == nullptr)
+    {
+        // Nothing to crossfade from yet, so the first engine is built here
+        activeEngine = std::make_unique<DdxReverbEngine>();
+        activeEngine->prepare(spec);
+        enginePrepared = true;
+
+        // It starts out with the parameters as they are - nothing is ringing
+        // yet, so the first block must not treat them as a preset switch
+        syncAppliedPreset();
+
+        // Preallocate the spare engine used for preset crossfades
+        setEngineTarget(spec, false);
+    }
+    else if (activeEngine->canReconfigure(spec))
+    {
+        // The new rate fits the existing delay memory: only the delay lengths
+        // and coefficients change. processBlock is not running during prepare.
+        activeEngine->reconfigure(spec);
+        setEngineTarget(spec, false);
+    }
+    else
+    {
+        // Keep the current engine running until its replacement is ready
+        requestEngineRebuild(spec);
+    }
+
+    // Until a rebuilt engine arrives the current one keeps its own rate
+    syncResampler(wetResamplers[static_cast<size_t>(activeResampler)], *activeEngine);
+
+    pipelineApplied = isPipelineRequested();
+    if (pipelineApplied)
+        pipelineWorker->start();
+
+    lastPrepareTimeMs = juce::Time::getMillisecondCounterHiRes() - prepareStart;
+}
+
+int DdxReverbAudioProcessor::getInternalRateFactor() const
+{
+    if (*apvts.getRawParameterValue("fixedrate") < 0.5f)
+        return 1;
+
+    return PolyphaseResampler::getFactorFor(currentSampleRate);
+}
+
+int DdxReverbAudioProcessor::getReportedLatency(int factor) const
+{
+    // The lane-packed modes never resample
+    if (getNetworkMode(*apvts.getRawParameterValue("quadmode") > 0.5f,
+                       *apvts.getRawParameterValue("stereomode") > 0.5f) != NetworkMode::mono)
+        return 0;
+
+    const int pipelineLatency = isPipelineRequested() ? pipelineWorker->getLatencySamples() : 0;
+
+    return PolyphaseResampler::getLatencyFor(factor) + pipelineLatency;
+}
+
+void DdxReverbAudioProcessor::handleAsyncUpdate()
+{
+    // The internal-rate toggle changes the network's rate, so it goes through
+    // the same background rebuild and crossfade as a sample-rate change
+    const int factor = getInternalRateFactor();
+    const ReverbEngineSpec spec { currentSampleRate / factor, targetEngineSpec.maxBlockSize };
+
+    setLatencySamples(getReportedLatency(factor));
+
+    if (spec != targetEngineSpec)
+        requestEngineRebuild(spec);
+
+    // The worker thread runs only while the pipeline mode is on. It goes
+    // once the audio thread has taken the network back.
+    if (isPipelineRequested())
+        pipelineWorker->launch();
+    else if (!pipelineApplied.load())
+        pipelineWorker->stopThread(2000);
+
+    updateRemoteEngine(currentSampleRate, targetEngineSpec.maxBlockSize);
+}
+
+bool DdxReverbAudioProcessor::isRemoteRequested() const noexcept
+{
+    return !isEngineProcess && SharedAudioRing::isSupported()
+        && *apvts.getRawParameterValue("outofprocess") > 0.5f;
+}
+
+juce::File DdxReverbAudioProcessor::getRemoteEngineExecutable()
+{
+    // Installed next to the plugin binary; the environment can point elsewhere
+    const auto overridePath = juce::SystemStats::getEnvironmentVariable("DDX3216_ENGINE_HOST", {});
+
+    if (overridePath.isNotEmpty())
+        return juce::File(overridePath);
+
+    return juce::File::getSpecialLocation(juce::File::currentExecutableFile).getSiblingFile("DDX3216EngineHost");
+}
+
+void DdxReverbAudioProcessor::updateRemoteEngine(double sampleRate, int maxBlockSize)
+{
+    const bool wanted = isRemoteRequested();
+
+    if (!wanted)
+        remoteFailures = 0;
+
+    if (wanted && remoteReady.load() && remoteEngine->matches(sampleRate, maxBlockSize))
+        return;
+
+    // Take the client away from the audio thread before touching it
+    remoteReady = false;
+
+    while (remoteInUse.load())
+        juce::Thread::yield();
+
+    remoteEngine->stop();
+
+    // An engine that keeps crashing is left alone until the mode is toggled
+    if (wanted && remoteFailures.load() < maxRemoteFailures)
+    {
+        if (remoteEngine->launch(getRemoteEngineExecutable(), sampleRate, maxBlockSize, static_cast<int>(stateValues.size())))
+            remoteReady = true;
+        else
+            ++remoteFailures;
+    }
+}
+
+// The in-process engine hears nothing while the engine process runs, so the
+// two paths never line up: every switch between them crossfades over one
+// block. Going local, the last block the engine returned fades out under
+// the first local one; coming back, this block also runs locally and
+// fades over to what the engine returned.
+void DdxReverbAudioProcessor::processRemoteOrLocalBlock(juce::AudioBuffer<float>& buffer, int numSamples, double startTime) noexcept
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), remoteFadeBuffer.getNumChannels());
+    const bool comingBack = remoteFadeSamples == 0 && remoteReady.load();
+
+    if (comingBack)
+        for (int channel = 0; channel < numChannels; ++channel)
+            localFadeBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+
+    if (!processRemoteBlock(buffer, numSamples))
+    {
+        processLocalBlock(buffer, startTime);
+
+        const int fadeSamples = juce::jmin(remoteFadeSamples, numSamples);
+
+        for (int channel = 0; channel < numChannels && fadeSamples > 0; ++channel)
+        {
+            buffer.applyGainRamp(channel, 0, fadeSamples, 0.0f, 1.0f);
+            buffer.addFromWithRamp(channel, 0, remoteFadeBuffer.getReadPointer(channel), fadeSamples, 1.0f, 0.0f);
+        }
+
+        remoteFadeSamples = 0;
+        return;
+    }
+
+    if (comingBack)
+    {
+        juce::AudioBuffer<float> localBlock(localFadeBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+        processLocalBlock(localBlock, startTime);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            buffer.applyGainRamp(channel, 0, numSamples, 0.0f, 1.0f);
+            buffer.addFromWithRamp(channel, 0, localBlock.getReadPointer(channel), numSamples, 1.0f, 0.0f);
+        }
+    }
+
+    // Kept to fade out from if the next block has to run here
+    for (int channel = 0; channel < numChannels; ++channel)
+        remoteFadeBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+
+    remoteFadeSamples = numSamples;
+
+    double expectedBlockTime = static_cast<double>(numSamples) / currentSampleRate;
+    cpuUsage = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0 / expectedBlockTime;
+    fadeCpuUsage = 0.0;
+    publishTelemetry(buffer, numSamples, 0.0f, 0.0f);
+}
+
+bool DdxReverbAudioProcessor::processRemoteBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    // Raised before looking at remoteReady, so the message thread either sees
+    // us in here or we see the client withdrawn
+    remoteInUse = true;
+    bool processed = false;
+
+    if (remoteReady.load())
+    {
+        const auto result = remoteEngine->process(buffer, numSamples, stateValues);
+        processed = result == RemoteEngineClient::Result::processed;
+        remoteLagging = result == RemoteEngineClient::Result::lagging;
+
+        if (processed)
+        {
+            remoteOverheadMicroseconds = remoteEngine->getOverheadMicroseconds();
+        }
+        else if (!remoteLagging)
+        {
+            // Dead, hung or too slow: carry on in-process and relaunch from the message thread
+            remoteReady = false;
+            ++remoteFailures;
+            triggerAsyncUpdate();
+        }
+    }
+
+    remoteInUse = false;
+    return processed;
+}
+
+void DdxReverbAudioProcessor::setParameterValues(const float* values, int numValues) noexcept
+{
+    const int count = juce::jmin(numValues, static_cast<int>(stateParameters.size()));
+
+    // Straight into the values processBlock reads: nothing in the engine
+    // process listens to its parameters, and notifying would take locks on
+    // its realtime thread
+    for (int i = 0; i < count; ++i)
+        stateValues[static_cast<size_t>(i)]->store(values[i], std::memory_order_relaxed);
+}
+
+void DdxReverbAudioProcessor::syncResampler(PolyphaseResampler& resampler, const DdxReverbEngine& engine) noexcept
+{
+    resampler.setFactor(juce::roundToInt(currentSampleRate / engine.getSpec().sampleRate));
+
+    // The dry path follows whichever engine is audible. This can run on the
+    // pipeline worker, so only the figure is published here and the audio
+    // thread picks it up in delayDrySignal().
+    if (&resampler == &wetResamplers[static_cast<size_t>(activeResampler)])
+        resamplerLatency = resampler.getLatencySamples();
+}
+
+void DdxReverbAudioProcessor::requestEngineRebuild(const ReverbEngineSpec& spec)
+{
+    setEngineTarget(spec, true);
+}
+
+void DdxReverbAudioProcessor::setEngineTarget(const ReverbEngineSpec& spec, bool rebuildActive)
+{
+    // A new generation makes anything built for an earlier target stale
+    targetEngineSpec = spec;
+    const auto generation = ++wantedEngineGeneration;
+    engineBuilder->setTargetSpec(spec, generation, rebuildActive);
+}
+
+double DdxReverbAudioProcessor::getTailLengthSeconds() const
+{
+    // Time for the tail to fall 120 dB (twice RT60) after the pre-delay. With
+    // Bass Multiply up the low band decays up to twice as slowly, and the last
+    // early reflection and a modulated comb read reach a little further back.
+    const float decayTime = *apvts.getRawParameterValue("decay");
+    const float predelayMs = *apvts.getRawParameterValue("predelay");
+    const float bassMult = *apvts.getRawParameterValue("bassmult");
+
+    const double lowBandScale = juce::jmax(1.0, std::exp2(static_cast<double>(bassMult) / DdxReverbEngine::bassMultPerDoubling));
+    const double reachSeconds = EarlyReflections::maxSpanSeconds + DdxReverbEngine::maxCombExcursionMs / 1000.0;
+
+    return predelayMs / 1000.0 + reachSeconds + 2.0 * decayTime * lowBandScale;
+}
+
+void DdxReverbAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    // Workers for splitting bounces, created the first time a host switches
+    // to offline - whether or not it prepares again afterwards. They exist
+    // before the flag is raised, so the audio thread never sees the flag
+    // without them. Realtime playback, and a host pool, never need them.
+    if (isNonRealtime && offlinePool == nullptr && hostTaskPool == nullptr)
+        offlinePool = std::make_unique<OfflineRenderPool>();
+
+    AudioProcessor::setNonRealtime(isNonRealtime);
+}
+
+void DdxReverbAudioProcessor::releaseResources()
+{
+    // Frees the worker's core until the next prepare
+    pipelineWorker->stopThread(2000);
+}
+
+bool DdxReverbAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Stereo, or a surround layout with one network lane per output channel
+    const auto mainOutput = layouts.getMainOutputChannelSet();
+
+    if (mainOutput != juce::AudioChannelSet::stereo()
+        && mainOutput != juce::AudioChannelSet::create5point0()
+        && mainOutput != juce::AudioChannelSet::create5point1()
+        && mainOutput != juce::AudioChannelSet::create7point0()
+        && mainOutput != juce::AudioChannelSet::create7point1())
+        return false;
+
+    if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::mono()
+        && layouts.getMainInputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // Extra send buses may each be off, mono or stereo
+    for (int bus = 1; bus < layouts.inputBuses.size(); ++bus)
+    {
+        const auto& set = layouts.inputBuses.getReference(bus);
+
+        if (!set.isDisabled() && set != juce::AudioChannelSet::mono() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
+    // Quad-mode outputs 2-4 are off or stereo
+    for (int bus = 1; bus < layouts.outputBuses.size(); ++bus)
+    {
+        const auto& set = layouts.outputBuses.getReference(bus);
+
+        if (!set.isDisabled() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+void DdxReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processBlockImpl(buffer);
+}
+
+void DdxReverbAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    // The lane modes and the engine process only run in float: hand them the
+    // block as float, as a single-precision host would have
+    const auto networkMode = getNetworkMode(*apvts.getRawParameterValue("quadmode") > 0.5f,
+                                            *apvts.getRawParameterValue("stereomode") > 0.5f);
+    const bool floatOnly = isRemoteRequested()
+        || networkMode == NetworkMode::quad || networkMode == NetworkMode::surround;
+
+    if (floatOnly)
+    {
+        precisionBuffer.makeCopyOf(buffer, true);
+        processBlockImpl(precisionBuffer);
+        buffer.makeCopyOf(precisionBuffer, true);
+        return;
+    }
+
+    processBlockImpl(buffer);
+}
+
+template <typename SampleType>
+void DdxReverbAudioProcessor::processBlockImpl(juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    // CPU monitoring
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    auto numSamples = buffer.getNumSamples();
+
+    // Clear unused output channels
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, numSamples);
+
+    // Unprepared. The flag rather than activeEngine itself: while pipelined
+    // the worker swaps that pointer for crossfades.
+    if (!enginePrepared.load())
+        return;
+
+    // Out-of-process mode: the engine process runs this same processBlock on
+    // the main stereo pair. A block it is late with is processed here instead,
+    // and so is everything after it if it dies, until a relaunch.
+    const bool remoteWanted = isRemoteRequested();
+
+    if (remoteWanted != remoteApplied)
+    {
+        remoteApplied = remoteWanted;
+        triggerAsyncUpdate();
+    }
+
+    // (A double-precision host's block arrives here as float in this mode)
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        if (remoteWanted && totalNumInputChannels <= 2 && totalNumOutputChannels == 2)
+        {
+            processRemoteOrLocalBlock(buffer, numSamples, startTime);
+            return;
+        }
+    }
+
+    remoteFadeSamples = 0;
+    processLocalBlock(buffer, startTime);
+}
+
+// Everything but the out-of-process hand-off
+template <typename SampleType>
+void DdxReverbAudioProcessor::processLocalBlock(juce::AudioBuffer<SampleType>& buffer, double startTime) noexcept
+{
+    const auto totalNumInputChannels = getTotalNumInputChannels();
+    const auto totalNumOutputChannels = getTotalNumOutputChannels();
+    const auto numSamples = buffer.getNumSamples();
+
+    // A send return has no dry path - bypassing it means silence
+    const bool sendMode = *apvts.getRawParameterValue("sendmode") > 0.5f;
+    const bool quadMode = *apvts.getRawParameterValue("quadmode") > 0.5f;
+    const bool stereoMode = *apvts.getRawParameterValue("stereomode") > 0.5f;
+
+    // Bypass - still delayed by the reported latency so the host's
+    // compensation stays lined up
+    if (*apvts.getRawParameterValue("bypass") > 0.5f)
+    {
+        if (quadMode)
+            return;
+
+        if (sendMode)
+            clearOutputs(buffer, numSamples);
+        else
+            delayDrySignal(buffer, numSamples);
+
+        return;
+    }
+
+    // Internal-rate / mode toggles: latency and the rebuild are handled on the message thread
+    const bool fixedRate = *apvts.getRawParameterValue("fixedrate") > 0.5f;
+    const auto networkMode = getNetworkMode(quadMode, stereoMode);
+
+    if (fixedRate != internalRateApplied || networkMode != networkModeApplied)
+    {
+        // Whichever network takes over starts without a stale tail (unless
+        // the pipeline worker has not handed the mono network back yet)
+        if (networkMode != networkModeApplied)
+        {
+            if (networkMode == NetworkMode::mono)
+            {
+                if (!pipelineApplied)
+                    activeEngine->reset();
+            }
+            else
+                setupLaneNetworks(networkMode);
+        }
+
+        internalRateApplied = fixedRate;
+        networkModeApplied = networkMode;
+        triggerAsyncUpdate();
+    }
+
+    // Pipeline toggle: the network goes to the worker as soon as the message
+    // thread has started it, but only comes back once the worker has
+    // finished everything it was given
+    const bool pipelineWanted = isPipelineRequested();
+
+    if (pipelineWanted != pipelineApplied)
+    {
+        if (pipelineWanted)
+        {
+            if (pipelineWorker->isThreadRunning())
+            {
+                pipelineWorker->start();
+                pipelineApplied = true;
+            }
+
+            triggerAsyncUpdate();
+        }
+        else if (pipelineWorker->isIdle())
+        {
+            pipelineApplied = false;
+            triggerAsyncUpdate();
+        }
+    }
+
+    if (networkMode == NetworkMode::quad || networkMode == NetworkMode::surround)
+    {
+        // Float only, like the out-of-process mode above
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            // The lane modes have no single network input: meter everything coming in
+            float laneInputPeak = 0.0f;
+
+            if (telemetryEnabled.load(std::memory_order_relaxed))
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    laneInputPeak = juce::jmax(laneInputPeak, TailEnergyTracker::getPeak(buffer.getReadPointer(channel), numSamples));
+
+            if (networkMode == NetworkMode::quad)
+                processQuadBlock(buffer, numSamples);
+            else
+                processSurroundBlock(buffer, numSamples);
+
+            double expectedBlockTime = static_cast<double>(numSamples) / currentSampleRate;
+            cpuUsage = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0 / expectedBlockTime;
+            fadeCpuUsage = 0.0;
+            publishTelemetry(buffer, numSamples, laneInputPeak, 0.0f);
+        }
+        else
+        {
+            jassertfalse;
+        }
+
+        return;
+    }
+
+    // Get parameters
+    float decayTime = *apvts.getRawParameterValue("decay");
+    float predelayMs = *apvts.getRawParameterValue("predelay");
+    float dampingPct = *apvts.getRawParameterValue("damping");
+    float diffusion = *apvts.getRawParameterValue("diffusion");
+    float hiCutDb = *apvts.getRawParameterValue("hicut");
+    float lowCutHz = *apvts.getRawParameterValue("lowcut");
+    float bassMult = *apvts.getRawParameterValue("bassmult");
+    float wetMix = *apvts.getRawParameterValue("wet");
+    useSIMD = *apvts.getRawParameterValue("simd") > 0.5f;
+
+    // Only send mode listens to the extra input buses
+    const int numNetworkInputs = sendMode ? totalNumInputChannels : getMainBusNumInputChannels();
+
+    // Input energy decides whether a sleeping network has to wake up
+    float inputPeak = 0.0f;
+    for (int channel = 0; channel < numNetworkInputs; ++channel)
+        inputPeak = juce::jmax(inputPeak, TailEnergyTracker::getPeak(buffer.getReadPointer(channel), numSamples));
+
+    if (tailTracker.isAsleep())
+    {
+        if (TailEnergyTracker::isSilent(inputPeak))
+        {
+            // Tail has died away and nothing is coming in: skip the network.
+            // A preset change has nothing ringing to crossfade from either.
+            presetSwitchPending = false;
+
+            if (sendMode)
+            {
+                clearOutputs(buffer, numSamples);
+            }
+            else
+            {
+                delayDrySignal(buffer, numSamples);
+                buffer.applyGain(1.0f - wetMix);
+            }
+
+            double expectedBlockTime = static_cast<double>(numSamples) / currentSampleRate;
+            cpuUsage = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0 / expectedBlockTime;
+            fadeCpuUsage = 0.0;
+            publishTelemetry(buffer, numSamples, inputPeak, 0.0f);
+            return;
+        }
+
+        tailTracker.wake();
+    }
+
+    auto* monoData = tempBuffer.getWritePointer(0);
+    auto& dry = getDryBuffer<SampleType>();
+    float* const* networkInputs = nullptr;
+
+    if (sendMode)
+    {
+        // Sum every send straight into the network input, then filter that
+        // single lane - there is no dry signal to keep
+        sumSendInputs(buffer, monoData, numSamples);
+
+        inputFilters.setLane(0, hiCutDb, lowCutHz);
+        inputFilters.process(&monoData, 1, numSamples);
+    }
+    else
+    {
+        // Store dry signal, lined up with the wet path's resampler latency.
+        // Copied channel by channel so enabled send buses are never picked up.
+        for (int channel = 0; channel < dry.getNumChannels(); ++channel)
+            dry.copyFrom(channel, 0, buffer, juce::jmin(channel, numNetworkInputs - 1), 0, numSamples);
+
+        delayDrySignal(dry, numSamples);
+
+        // Hi-shelf cut / low-cut per input channel (one SIMD lane each) - the
+        // dry copy is already taken, so the wet input is filtered in place
+        const int numInputLanes = juce::jmin(numNetworkInputs, 2);
+        networkInputs = getNetworkInputs(buffer, numInputLanes, numSamples);
+
+        for (int lane = 0; lane < numInputLanes; ++lane)
+            inputFilters.setLane(lane, hiCutDb, lowCutHz);
+
+        inputFilters.process(networkInputs, numInputLanes, numSamples);
+
+        // Convert to mono (sum L+R) - the true-stereo network reads L/R directly
+        if (!stereoMode)
+            juce::FloatVectorOperations::copy(monoData, networkInputs[0], numSamples);
+
+        if (!stereoMode && numNetworkInputs > 1)
+        {
+            juce::FloatVectorOperations::add(monoData, networkInputs[1], numSamples);
+            juce::FloatVectorOperations::multiply(monoData, 0.5f, numSamples);
+        }
+    }
+
+    // Wet signal per output side; the mono network feeds both, with the
+    // right side inverted for width (DDX3216 style)
+    const float* wetLeft = monoData;
+    const float* wetRight = monoData;
+    float rightPolarity = -1.0f;
+    float wetPeak = 0.0f;
+    double fadeTimeMs = 0.0;
+
+    if (stereoMode)
+    {
+        // True stereo: L and R networks with offset delays in adjacent lanes
+        auto* const* lanes = laneBuffer.getArrayOfWritePointers();
+
+        juce::FloatVectorOperations::copy(lanes[0], sendMode ? monoData : networkInputs[0], numSamples);
+        juce::FloatVectorOperations::copy(lanes[1], sendMode ? monoData : networkInputs[juce::jmin(1, numNetworkInputs - 1)], numSamples);
+
+        for (int lane = 0; lane < 2; ++lane)
+            setLaneParameters(lane, decayTime, predelayMs, dampingPct, diffusion);
+
+        processLanes(2, numSamples);
+
+        // No engine crossfades in this mode
+        presetSwitchPending = false;
+
+        wetLeft = lanes[0];
+        wetRight = lanes[1];
+        rightPolarity = 1.0f;
+        wetPeak = juce::jmax(TailEnergyTracker::getPeak(wetLeft, numSamples), TailEnergyTracker::getPeak(wetRight, numSamples));
+    }
+    else if (pipelineApplied)
+    {
+        // The worker owns the network: hand it this block and take back the
+        // previous one. While switching off, nothing new goes out.
+        if (pipelineWanted)
+            pipelineWorker->push(monoData, numSamples);
+
+        pipelineWorker->pull(monoData, numSamples);
+        wetPeak = TailEnergyTracker::getPeak(monoData, numSamples);
+    }
+    else
+    {
+        fadeTimeMs = processMonoNetwork(monoData, numSamples, decayTime, predelayMs, dampingPct, diffusion, bassMult);
+        wetPeak = TailEnergyTracker::getPeak(monoData, numSamples);
+    }
+
+    // Once input and output have been quiet for the hold time, confirm the
+    // delay memory itself has decayed below -120 dBFS before sleeping. The
+    // worker's network can't be inspected from here, so a pipeline stays awake.
+    if (!pipelineApplied
+        && tailTracker.update(inputPeak, wetPeak, numSamples)
+        && fadingEngine == nullptr)
+    {
+        const float statePeak = stereoMode ? getLaneStatePeak() : activeEngine->getStatePeak();
+
+        if (TailEnergyTracker::isSilent(statePeak))
+            tailTracker.sleep();
+        else
+            tailTracker.rearm();
+    }
+
+    if (sendMode)
+    {
+        // Send return: wet only, no mix pass, same polarity split as the insert path
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+        {
+            auto* outData = buffer.getWritePointer(channel);
+
+            MixedPrecision::copy(outData, channel == 1 ? wetRight : wetLeft, numSamples);
+
+            if (channel == 1 && rightPolarity != 1.0f)
+                juce::FloatVectorOperations::multiply(outData, static_cast<SampleType>(rightPolarity), numSamples);
+        }
+    }
+    else
+    {
+        // Mix wet/dry (output to stereo with phase inversion for width)
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+        {
+            auto* outData = buffer.getWritePointer(channel);
+            auto* dryData = dry.getReadPointer(juce::jmin(channel, dry.getNumChannels() - 1));
+
+            // Dry signal (1 - wet)
+            juce::FloatVectorOperations::copy(outData, dryData, numSamples);
+            juce::FloatVectorOperations::multiply(outData, static_cast<SampleType>(1.0f - wetMix), numSamples);
+
+            // Add wet signal - STEREO WIDTH: mono network inverts the right channel
+            if (channel == 1)
+            {
+                // Right channel: inverted (mono) or its own network (true stereo)
+                MixedPrecision::addWithMultiply(outData, wetRight, static_cast<SampleType>(rightPolarity * wetMix), numSamples);
+            }
+            else
+            {
+                // Left channel: normal polarity
+                MixedPrecision::addWithMultiply(outData, wetLeft, static_cast<SampleType>(wetMix), numSamples);
+            }
+        }
+    }
+
+    // Update CPU usage
+    auto endTime = juce::Time::getMillisecondCounterHiRes();
+    double blockTime = (endTime - startTime) / 1000.0; // seconds
+    double expectedBlockTime = static_cast<double>(numSamples) / currentSampleRate;
+    cpuUsage = blockTime / expectedBlockTime;
+    fadeCpuUsage = (fadeTimeMs / 1000.0) / expectedBlockTime;
+
+    // Cap the second engine's cost: if it ate more than its share of the
+    // block, finish the crossfade in half the remaining time
+    if (fadeCpuUsage > maxFadeCpuUsage)
+        engineFadeRemaining /= 2;
+
+    updateCpuGuard(numSamples);
+    publishTelemetry(buffer, numSamples, inputPeak, wetPeak);
+}
+
+template <typename SampleType>
+void DdxReverbAudioProcessor::publishTelemetry(const juce::AudioBuffer<SampleType>& buffer, int numSamples,
+                                               float inputPeak, float wetPeak) noexcept
+{
+    // Nobody is looking: don't even scan the output
+    if (!telemetryEnabled.load(std::memory_order_relaxed))
+        return;
+
+    auto& snapshot = telemetry.getWriteSlot();
+
+    snapshot.cpuUsage = static_cast<float>(cpuUsage);
+    snapshot.fadeCpuUsage = static_cast<float>(fadeCpuUsage);
+    snapshot.blockSize = numSamples;
+    snapshot.sampleRate = currentSampleRate;
+    snapshot.algorithm = static_cast<ReverbAlgorithm>(juce::roundToInt(apvts.getRawParameterValue("algorithm")->load()));
+    snapshot.simd = *apvts.getRawParameterValue("simd") > 0.5f;
+    snapshot.pipelined = pipelineApplied;
+    snapshot.doublePrecision = isUsingDoublePrecision();
+    snapshot.wideAccumulation = *apvts.getRawParameterValue("wideaccum") > 0.5f;
+    snapshot.asleep = tailTracker.isAsleep();
+    snapshot.qualityTier = reportedQualityTier.load();
+    snapshot.pipelineUnderruns = pipelineWorker->getNumUnderruns();
+    snapshot.remoteOverheadMicroseconds = remoteReady.load() ? remoteOverheadMicroseconds : 0.0f;
+    snapshot.remoteLagging = remoteReady.load() && remoteLagging;
+    snapshot.inputPeak = inputPeak;
+    snapshot.wetPeak = wetPeak;
+    snapshot.outputPeak = 0.0f;
+
+    for (int channel = 0; channel < getMainBusNumOutputChannels(); ++channel)
+        snapshot.outputPeak = juce::jmax(snapshot.outputPeak, TailEnergyTracker::getPeak(buffer.getReadPointer(channel), numSamples));
+
+    telemetry.publish();
+}
+
+RenderTaskPool* DdxReverbAudioProcessor::getTaskPool(int numSamples) const noexcept
+{
+    if (numSamples < RenderTaskPool::minParallelSamples)
+        return nullptr;
+
+    // A host pool is realtime-capable; our own only runs during bounces
+    if (hostTaskPool != nullptr)
+        return hostTaskPool;
+
+    return isNonRealtime() ? offlinePool.get() : nullptr;
+}
+
+void DdxReverbAudioProcessor::setHostTaskPool(RenderTaskPool* pool) noexcept
+{
+    hostTaskPool = pool;
+}
+
+bool DdxReverbAudioProcessor::isPipelineRequested() const noexcept
+{
+    // Only the mono network is pipelined; the lane modes stay on the audio thread
+    return *apvts.getRawParameterValue("pipeline") > 0.5f
+        && getNetworkMode(*apvts.getRawParameterValue("quadmode") > 0.5f,
+                          *apvts.getRawParameterValue("stereomode") > 0.5f) == NetworkMode::mono;
+}
+
+// Runs on the pipeline worker with the parameters as they are now
+void DdxReverbAudioProcessor::processPipelinedBlock(float* monoData, int numSamples) noexcept
+{
+    processMonoNetwork(monoData, numSamples,
+                       apvts.getRawParameterValue("decay")->load(),
+                       apvts.getRawParameterValue("predelay")->load(),
+                       apvts.getRawParameterValue("damping")->load(),
+                       apvts.getRawParameterValue("diffusion")->load(),
+                       apvts.getRawParameterValue("bassmult")->load());
+}
+
+EarlyPattern DdxReverbAudioProcessor::getEarlyPattern(ReverbAlgorithm algorithm, ReverbProgram program) const noexcept
+{
+    // Auto follows the program, except in the velvet preview mode
+    const int earlyChoice = juce::roundToInt(apvts.getRawParameterValue("early")->load());
+
+    return earlyChoice != 0 ? static_cast<EarlyPattern>(earlyChoice - 1)
+         : algorithm == ReverbAlgorithm::velvet ? EarlyPattern::off
+         : DdxReverbEngine::getProgramEarlyPattern(program);
+}
+
+void DdxReverbAudioProcessor::syncAppliedPreset() noexcept
+{
+    algorithmApplied = static_cast<ReverbAlgorithm>(juce::roundToInt(apvts.getRawParameterValue("algorithm")->load()));
+    programApplied = static_cast<ReverbProgram>(juce::roundToInt(apvts.getRawParameterValue("program")->load()));
+    earlyPatternApplied = getEarlyPattern(algorithmApplied, programApplied);
+    modulationApplied = static_cast<DelayModulation>(juce::roundToInt(apvts.getRawParameterValue("modulation")->load()));
+    presetSwitchPending = false;
 }
 
-DdxReverbAudioProcessor::~DdxReverbAudioProcessor()
+void DdxReverbAudioProcessor::updateNetworkCycles(ReverbAlgorithm algorithm, double networkTimeMs, int numSamples) noexcept
 {
+    if (cpuSpeedMHz <= 0 || numSamples <= 0)
+        return;
+
+    const auto cycles = static_cast<float>(networkTimeMs * 1000.0 * cpuSpeedMHz / numSamples);
+    auto& smoothed = networkCyclesPerSample[static_cast<size_t>(algorithm)];
+    const float previous = smoothed.load();
+
+    smoothed = previous > 0.0f ? previous + 0.1f * (cycles - previous) : cycles;
 }
 
-//==============================================================================
-juce::AudioProcessorValueTreeState::ParameterLayout DdxReverbAudioProcessor::createParameterLayout()
+double DdxReverbAudioProcessor::processMonoNetwork(float* monoData, int numSamples, float decayTime, float predelayMs,
+                                                  float dampingPct, float diffusion, float bassMult) noexcept
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    // Swap in a freshly built engine once the previous swap has been collected
+    if (fadingEngine == nullptr && retiredEngine.load() == nullptr)
+    {
+        auto* nextEngine = pendingEngine.exchange(nullptr);
 
-    // DDX3216 Cathedral parameters (based on SysEx spec)
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "decay", "Decay Time",
-        juce::NormalisableRange<float>(2.0f, 20.0f, 0.1f), 5.0f, "s"));
+        // Drop engines built for a target that has since been superseded
+        if (nextEngine != nullptr && nextEngine->getGeneration() != wantedEngineGeneration.load())
+        {
+            retiredEngine.store(nextEngine);
+            nextEngine = nullptr;
+        }
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "predelay", "Pre-Delay",
-        juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f), 50.0f, "ms"));
+        if (nextEngine != nullptr)
+        {
+            fadingEngine = std::move(activeEngine);
+            activeEngine.reset(nextEngine);
+            activeResampler = 1 - activeResampler;
+            syncResampler(wetResamplers[static_cast<size_t>(activeResampler)], *activeEngine);
+            startEngineCrossfade(engineFadeSeconds, false);
+        }
+    }
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "damping", "Damping (Hi Decay)",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 50.0f, "%"));
+    // An algorithm change crossfades through the spare engine like a preset
+    const auto algorithm = static_cast<ReverbAlgorithm>(juce::roundToInt(apvts.getRawParameterValue("algorithm")->load()));
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "diffusion", "Diffusion",
-        juce::NormalisableRange<float>(0.0f, 20.0f, 0.1f), 10.0f));
+    if (algorithm != algorithmApplied)
+    {
+        algorithmApplied = algorithm;
+        presetSwitchPending = true;
+    }
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "hicut", "Hi Shelf Cut",
-        juce::NormalisableRange<float>(0.0f, 30.0f, 0.1f), 0.0f, "dB"));
+    // So does a program change
+    const auto program = static_cast<ReverbProgram>(juce::roundToInt(apvts.getRawParameterValue("program")->load()));
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "bassmult", "Bass Multiply",
-        juce::NormalisableRange<float>(-10.0f, 10.0f, 0.1f), 0.0f));
+    if (program != programApplied)
+    {
+        programApplied = program;
+        presetSwitchPending = true;
+    }
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "wet", "Wet/Dry Mix",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+    // And a different early-reflection pattern
+    const auto earlyPattern = getEarlyPattern(algorithm, program);
 
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        "bypass", "Bypass", false));
+    if (earlyPattern != earlyPatternApplied)
+    {
+        earlyPatternApplied = earlyPattern;
+        presetSwitchPending = true;
+    }
 
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        "simd", "Use SIMD (Low CPU)", false));
+    // Switching modulation on or off restarts the modulated stages, so it
+    // crossfades too; depth and rate just follow
+    const auto modulation = static_cast<DelayModulation>(juce::roundToInt(apvts.getRawParameterValue("modulation")->load()));
+    const float modulationDepth = *apvts.getRawParameterValue("moddepth");
+    const float modulationRate = *apvts.getRawParameterValue("modrate");
 
-    return { params.begin(), params.end() };
-}
+    if (modulation != modulationApplied)
+    {
+        modulationApplied = modulation;
+        presetSwitchPending = true;
+    }
 
-//==============================================================================
-void DdxReverbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
-{
-    currentSampleRate = sampleRate;
+    // Preset change: the current engine keeps ringing with the old coefficients
+    // while the spare takes over with the new ones, then the old one is recycled
+    if (fadingEngine == nullptr && retiredEngine.load() == nullptr && presetSwitchPending.exchange(false))
+    {
+        const float presetFadeMs = *apvts.getRawParameterValue("xfade");
+        auto* spare = presetFadeMs > 0.0f ? spareEngine.exchange(nullptr) : nullptr;
 
-    // Allocate buffers
-    dryBuffer.setSize(2, samplesPerBlock);
-    tempBuffer.setSize(1, samplesPerBlock);
+        if (spare != nullptr && spare->getSpec() == activeEngine->getSpec())
+        {
+            presetFadeActive = true;
+            fadingEngine = std::move(activeEngine);
+            activeEngine.reset(spare);
+            activeResampler = 1 - activeResampler;
+            syncResampler(wetResamplers[static_cast<size_t>(activeResampler)], *activeEngine);
+            startEngineCrossfade(presetFadeMs / 1000.0, true);
+        }
+        else if (spare != nullptr)
+        {
+            // Stale spare from before a sample-rate change - hard switch instead
+            retiredEngine.store(spare);
+        }
+    }
+
+    activeEngine->setAlgorithm(algorithm);
+    activeEngine->setProgram(program);
+    activeEngine->setEarlyPattern(earlyPattern);
+    activeEngine->setModulation(modulation, modulationDepth, modulationRate);
+    activeEngine->setParameters(decayTime, predelayMs, dampingPct, diffusion, bassMult);
+    activeEngine->setQualityTier(reportedQualityTier.load());
 
-    // Pre-delay buffer (max 500ms)
-    int maxPreDelay = static_cast<int>(sampleRate * 0.5);
-    preDelayBuffer.resize(static_cast<size_t>(maxPreDelay));
-    std::fill(preDelayBuffer.begin(), preDelayBuffer.end(), 0.0f);
-    preDelayWritePos = 0;
+    // Only rounding changes, so both engines follow at once
+    const bool wideAccumulation = *apvts.getRawParameterValue("wideaccum") > 0.5f;
+    activeEngine->setWideAccumulation(wideAccumulation);
 
-    // Prepare comb filters
-    int maxCombDelay = static_cast<int>(sampleRate * 0.1); // 100ms max
-    for (int i = 0; i < numCombs; ++i)
+    // The outgoing engine keeps ringing on the same input until the fade ends
+    auto* fadeData = fadeBuffer.getWritePointer(0);
+    double fadeTimeMs = 0.0;
+
+    if (fadingEngine != nullptr)
     {
-        combs[i].prepare(sampleRate, maxCombDelay, 0.7f, 5000.0f);
+        juce::FloatVectorOperations::copy(fadeData, monoData, numSamples);
+
+        if (!fadeIsPresetSwitch)
+        {
+            fadingEngine->setAlgorithm(algorithm);
+            fadingEngine->setProgram(program);
+            fadingEngine->setEarlyPattern(earlyPattern);
+            fadingEngine->setModulation(modulation, modulationDepth, modulationRate);
+            fadingEngine->setParameters(decayTime, predelayMs, dampingPct, diffusion, bassMult);
+        }
 
-        // Scale delays to current sample rate
-        int scaledDelay = static_cast<int>(combDelays[i] * sampleRate / 48000.0);
-        combs[i].setDelaySamples(scaledDelay);
+        fadingEngine->setQualityTier(reportedQualityTier.load());
+        fadingEngine->setWideAccumulation(wideAccumulation);
     }
 
-    // Prepare all-pass filters
-    int maxAPDelay = static_cast<int>(sampleRate * 0.05); // 50ms max
-    for (int i = 0; i < numAllpasses; ++i)
+    // With a task pool the two engines of a crossfade run side by side; each has its
+    // own resampler and buffers, and they only meet in the crossfade below
+    const auto runEngine = [&](int task)
     {
-        allpasses[i].prepare(sampleRate, maxAPDelay, 0.5f);
+        const auto networkStart = juce::Time::getMillisecondCounterHiRes();
+
+        if (task == 0)
+        {
+            processWetPath(*activeEngine, wetResamplers[static_cast<size_t>(activeResampler)], monoData, numSamples);
+            updateNetworkCycles(algorithm, juce::Time::getMillisecondCounterHiRes() - networkStart, numSamples);
+        }
+        else
+        {
+            processWetPath(*fadingEngine, wetResamplers[static_cast<size_t>(1 - activeResampler)], fadeData, numSamples);
+            fadeTimeMs = juce::Time::getMillisecondCounterHiRes() - networkStart;
+        }
+    };
+
+    const int numEngines = fadingEngine != nullptr ? 2 : 1;
+
+    if (auto* pool = getTaskPool(numSamples))
+        pool->forEach(numEngines, runEngine);
+    else
+        for (int task = numEngines - 1; task >= 0; --task)
+            runEngine(task);
+
+    if (fadingEngine != nullptr)
+        applyEngineCrossfade(monoData, fadeData, numSamples);
+
+    return fadeTimeMs;
+}
+
+void DdxReverbAudioProcessor::processWetPath(DdxReverbEngine& engine, PolyphaseResampler& resampler,
+                                             float* data, int numSamples) noexcept
+{
+    // Forks inside the engine go to the same pool
+    auto* pool = getTaskPool(numSamples);
 
-        // Scale delays to current sample rate
-        int scaledDelay = static_cast<int>(allpassDelays[i] * sampleRate / 48000.0);
-        allpasses[i].setDelaySamples(scaledDelay);
+    if (resampler.getFactor() == 1)
+    {
+        engine.process(data, numSamples, useSIMD, pool);
+        return;
     }
+
+    // Only the wet network runs at the internal rate; each resampler has
+    // its own scratch channel so both crossfade engines can run at once
+    auto* internalData = internalBuffer.getWritePointer(static_cast<int>(&resampler - wetResamplers.data()));
+    const int numInternal = resampler.decimate(data, numSamples, internalData);
+
+    engine.process(internalData, numInternal, useSIMD, pool);
+    resampler.interpolate(internalData, numInternal, data, numSamples);
 }
 
-void DdxReverbAudioProcessor::releaseResources()
+bool DdxReverbAudioProcessor::isLaneModeActive() const noexcept
 {
+    return getNetworkMode(*apvts.getRawParameterValue("quadmode") > 0.5f,
+                          *apvts.getRawParameterValue("stereomode") > 0.5f) != NetworkMode::mono;
 }
 
-bool DdxReverbAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+DdxReverbAudioProcessor::NetworkMode DdxReverbAudioProcessor::getNetworkMode(bool quadMode, bool stereoMode) const noexcept
 {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
+    if (quadMode)
+        return NetworkMode::quad;
 
-    if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainInputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
+    // A surround output always gets one network per channel
+    if (getMainBusNumOutputChannels() > 2)
+        return NetworkMode::surround;
 
-    return true;
+    return stereoMode ? NetworkMode::stereo : NetworkMode::mono;
 }
 
-//==============================================================================
-void DdxReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void DdxReverbAudioProcessor::setupLaneNetworks(NetworkMode mode) noexcept
 {
-    juce::ScopedNoDenormals noDenormals;
+    for (int lane = 0; lane < numLaneNetworks * LaneReverbNetwork::maxLanes; ++lane)
+    {
+        int spread = 0;
 
-    // CPU monitoring
-    auto startTime = juce::Time::getMillisecondCounterHiRes();
+        if (mode == NetworkMode::stereo && lane == 1)
+            spread = stereoSpread;
+        else if (mode == NetworkMode::surround && lane < maxSurroundChannels)
+            spread = surroundSpreads[lane];
 
-    auto totalNumInputChannels = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-    auto numSamples = buffer.getNumSamples();
+        laneNetworks[static_cast<size_t>(lane / LaneReverbNetwork::maxLanes)].setLaneSpread(lane % LaneReverbNetwork::maxLanes, spread);
+    }
 
-    // Clear unused output channels
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, numSamples);
+    for (auto& network : laneNetworks)
+        network.reset();
+}
 
-    // Bypass
-    if (*apvts.getRawParameterValue("bypass") > 0.5f)
-        return;
+void DdxReverbAudioProcessor::setLaneParameters(int lane, float decayTime, float predelayMs,
+                                                float dampingPct, float diffusion) noexcept
+{
+    laneNetworks[static_cast<size_t>(lane / LaneReverbNetwork::maxLanes)]
+        .setLaneParameters(lane % LaneReverbNetwork::maxLanes, decayTime, predelayMs, dampingPct, diffusion);
+}
 
-    // Get parameters
-    float decayTime = *apvts.getRawParameterValue("decay");
-    float predelayMs = *apvts.getRawParameterValue("predelay");
-    float dampingPct = *apvts.getRawParameterValue("damping");
-    float diffusion = *apvts.getRawParameterValue("diffusion");
-    float hiCutDb = *apvts.getRawParameterValue("hicut");
-    float bassMult = *apvts.getRawParameterValue("bassmult");
-    float wetMix = *apvts.getRawParameterValue("wet");
-    useSIMD = *apvts.getRawParameterValue("simd") > 0.5f;
+void DdxReverbAudioProcessor::processLanes(int numLanes, int numSamples) noexcept
+{
+    // One vector pass per network; 7.1 fits a single AVX register
+    auto* const* lanes = laneBuffer.getArrayOfWritePointers();
+
+    // Every lane runs the program's comb/all-pass network
+    const auto program = static_cast<ReverbProgram>(juce::roundToInt(apvts.getRawParameterValue("program")->load()));
+
+    for (auto& network : laneNetworks)
+        network.setProgram(program);
+
+    const int numNetworks = (numLanes + LaneReverbNetwork::maxLanes - 1) / LaneReverbNetwork::maxLanes;
+
+    const auto runNetwork = [&](int n)
+    {
+        const int first = n * LaneReverbNetwork::maxLanes;
+        laneNetworks[static_cast<size_t>(n)].process(lanes + first, juce::jmin(LaneReverbNetwork::maxLanes, numLanes - first), numSamples);
+    };
+
+    // With a task pool each network (7.1 on SSE/NEON has two) is its own task
+    if (auto* pool = getTaskPool(numSamples))
+        pool->forEach(numNetworks, runNetwork);
+    else
+        for (int n = 0; n < numNetworks; ++n)
+            runNetwork(n);
+}
+
+float DdxReverbAudioProcessor::getLaneStatePeak() const noexcept
+{
+    float peak = 0.0f;
+
+    for (auto& network : laneNetworks)
+        peak = juce::jmax(peak, network.getStatePeak());
+
+    return peak;
+}
 
-    // Store dry signal
-    dryBuffer.makeCopyOf(buffer, true);
+void DdxReverbAudioProcessor::processSurroundBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    const auto layout = getChannelLayoutOfBus(false, 0);
+    const int numOutputs = juce::jmin(layout.size(), maxSurroundChannels);
+    const int numInputs = getMainBusNumInputChannels();
+
+    const float wetMix = *apvts.getRawParameterValue("wet");
 
-    // Convert to mono (sum L+R)
+    // Dry copy of the main input first - input and output share channels
+    for (int channel = 0; channel < dryBuffer.getNumChannels(); ++channel)
+        dryBuffer.copyFrom(channel, 0, buffer, juce::jmin(channel, numInputs - 1), 0, numSamples);
+
+    // Filtered mono sum feeds every lane
     auto* monoData = tempBuffer.getWritePointer(0);
     juce::FloatVectorOperations::copy(monoData, buffer.getReadPointer(0), numSamples);
 
-    if (totalNumInputChannels > 1)
+    if (numInputs > 1)
     {
         juce::FloatVectorOperations::add(monoData, buffer.getReadPointer(1), numSamples);
         juce::FloatVectorOperations::multiply(monoData, 0.5f, numSamples);
     }
 
-    // Apply hi-cut filter (input lowpass)
-    if (hiCutDb > 0.01f)
+    inputFilters.setLane(0, *apvts.getRawParameterValue("hicut"), *apvts.getRawParameterValue("lowcut"));
+    inputFilters.process(&monoData, 1, numSamples);
+
+    const float decayTime = *apvts.getRawParameterValue("decay");
+    const float predelayMs = *apvts.getRawParameterValue("predelay");
+    const float dampingPct = *apvts.getRawParameterValue("damping");
+    const float diffusion = *apvts.getRawParameterValue("diffusion");
+
+    for (int channel = 0; channel < numOutputs; ++channel)
+    {
+        // No reverb into the LFE
+        if (layout.getTypeOfChannel(channel) == juce::AudioChannelSet::LFE)
+            laneBuffer.clear(channel, 0, numSamples);
+        else
+            laneBuffer.copyFrom(channel, 0, monoData, numSamples);
+
+        setLaneParameters(channel, decayTime, predelayMs, dampingPct, diffusion);
+    }
+
+    processLanes(numOutputs, numSamples);
+
+    // Dry goes to the front left/right only; every channel gets its own tail
+    for (int channel = 0; channel < numOutputs; ++channel)
     {
-        float cutoffGain = juce::Decibels::decibelsToGain(-hiCutDb);
-        static float prevSample = 0.0f;
-        for (int i = 0; i < numSamples; ++i)
+        auto* outData = buffer.getWritePointer(channel);
+        const auto type = layout.getTypeOfChannel(channel);
+
+        if (type == juce::AudioChannelSet::left || type == juce::AudioChannelSet::right)
+        {
+            juce::FloatVectorOperations::copy(outData, dryBuffer.getReadPointer(type == juce::AudioChannelSet::left ? 0 : 1), numSamples);
+            juce::FloatVectorOperations::multiply(outData, 1.0f - wetMix, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(outData, laneBuffer.getReadPointer(channel), wetMix, numSamples);
+        }
+        else
         {
-            prevSample = prevSample + cutoffGain * (monoData[i] - prevSample);
-            monoData[i] = prevSample;
+            juce::FloatVectorOperations::copy(outData, laneBuffer.getReadPointer(channel), numSamples);
+            juce::FloatVectorOperations::multiply(outData, wetMix, numSamples);
         }
     }
+}
+
+void DdxReverbAudioProcessor::processQuadBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    // Read every input bus before any output is written - the host may
+    // share channels between an input bus and an output bus
+    for (int engine = 0; engine < numQuadEngines; ++engine)
+    {
+        auto* lane = laneBuffer.getWritePointer(engine);
+        juce::FloatVectorOperations::clear(lane, numSamples);
+        quadDryBuffer.clear(2 * engine, 0, numSamples);
+        quadDryBuffer.clear(2 * engine + 1, 0, numSamples);
+
+        if (engine >= getBusCount(true))
+            continue;
+
+        auto input = getBusBuffer(buffer, true, engine);
+        const int numChannels = input.getNumChannels();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(lane, input.getReadPointer(channel),
+                                                         1.0f / static_cast<float>(numChannels), numSamples);
 
-    // Pre-delay - CORRECTED: Read old sample FIRST, then write new
-    preDelaySamples = static_cast<int>(predelayMs * currentSampleRate / 1000.0f);
-    preDelaySamples = juce::jlimit(0, static_cast<int>(preDelayBuffer.size()) - 1, preDelaySamples);
+        for (int channel = 0; channel < 2 && numChannels > 0; ++channel)
+            quadDryBuffer.copyFrom(2 * engine + channel, 0, input, juce::jmin(channel, numChannels - 1), 0, numSamples);
+    }
 
-    if (preDelaySamples > 0)
+    // Every engine has its own filter lane and network lane
+    for (int engine = 0; engine < numQuadEngines; ++engine)
     {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            // Calculate read position (looking back in time)
-            int readPos = preDelayWritePos - preDelaySamples;
-            if (readPos < 0)
-                readPos += static_cast<int>(preDelayBuffer.size());
+        const auto& values = quadParameters[static_cast<size_t>(engine)];
 
-            // 1. READ old delayed sample
-            float delayed = preDelayBuffer[static_cast<size_t>(readPos)];
+        quadFilters.setLane(engine, values.hicut->load(), values.lowcut->load());
+        setLaneParameters(engine, values.decay->load(), values.predelay->load(),
+                          values.damping->load(), values.diffusion->load());
+    }
+
+    quadFilters.process(laneBuffer.getArrayOfWritePointers(), numQuadEngines, numSamples);
+    processLanes(numQuadEngines, numSamples);
 
-            // 2. WRITE current input to buffer
-            preDelayBuffer[static_cast<size_t>(preDelayWritePos)] = monoData[i];
+    // Mix each engine onto its own output bus, right channel inverted as usual
+    for (int engine = 0; engine < juce::jmin(numQuadEngines, getBusCount(false)); ++engine)
+    {
+        auto output = getBusBuffer(buffer, false, engine);
+        const float wetMix = quadParameters[static_cast<size_t>(engine)].wet->load();
+        const auto* wetData = laneBuffer.getReadPointer(engine);
 
-            // 3. OUTPUT the delayed sample
-            monoData[i] = delayed;
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            auto* outData = output.getWritePointer(channel);
 
-            // 4. Advance write position
-            if (++preDelayWritePos >= static_cast<int>(preDelayBuffer.size()))
-                preDelayWritePos = 0;
+            juce::FloatVectorOperations::copy(outData, quadDryBuffer.getReadPointer(2 * engine + juce::jmin(channel, 1)), numSamples);
+            juce::FloatVectorOperations::multiply(outData, 1.0f - wetMix, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(outData, wetData, channel == 1 ? -wetMix : wetMix, numSamples);
         }
     }
+}
+
+template <typename SampleType>
+void DdxReverbAudioProcessor::sumSendInputs(juce::AudioBuffer<SampleType>& buffer, float* monoData, int numSamples) noexcept
+{
+    juce::FloatVectorOperations::clear(monoData, numSamples);
+
+    for (int bus = 0; bus < getBusCount(true); ++bus)
+    {
+        auto send = getBusBuffer(buffer, true, bus);
+        const int numChannels = send.getNumChannels();
 
-    // Update comb filter parameters
-    // Damping: 0% = bright (20kHz), 100% = dark (2kHz)
-    float dampingFreq = juce::jmap(dampingPct, 0.0f, 100.0f, 20000.0f, 2000.0f);
+        // Disabled buses have no channels
+        if (numChannels == 0)
+            continue;
 
-    // Decay time affects feedback gain: RT60 = -60dB decay time
-    // g = 10^(-3 * T / RT60) where T is delay time in seconds
-    float avgDelayMs = (combDelays[0] + combDelays[1] + combDelays[2] + combDelays[3]) / 4.0f
-        * 1000.0f / static_cast<float>(currentSampleRate);
-    float combGain = std::pow(10.0f, -3.0f * avgDelayMs / (decayTime * 1000.0f));
-    combGain = juce::jlimit(0.1f, 0.99f, combGain);
+        // Each stereo send is folded to mono like the insert path; sends add
+        const float gain = 1.0f / static_cast<float>(numChannels);
 
-    // Bass multiply boosts/cuts low-frequency decay
-    combGain *= (1.0f + bassMult * 0.05f);
+        for (int channel = 0; channel < numChannels; ++channel)
+            MixedPrecision::addWithMultiply(monoData, send.getReadPointer(channel), gain, numSamples);
+    }
+}
 
-    for (auto& comb : combs)
+template <typename SampleType>
+float* const* DdxReverbAudioProcessor::getNetworkInputs(juce::AudioBuffer<SampleType>& buffer, int numChannels, int numSamples) noexcept
+{
+    if constexpr (std::is_same_v<SampleType, float>)
     {
-        comb.setDampingFreq(dampingFreq);
-        comb.setGain(combGain);
+        return buffer.getArrayOfWritePointers();
     }
+    else
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            MixedPrecision::copy(networkInputBuffer.getWritePointer(channel), buffer.getReadPointer(channel), numSamples);
+
+        return networkInputBuffer.getArrayOfWritePointers();
+    }
+}
 
-    // Process parallel combs - accumulate in monoData
-    juce::AudioBuffer<float> combBuffer(1, numSamples);
+template <typename SampleType>
+void DdxReverbAudioProcessor::clearOutputs(juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept
+{
+    for (int channel = 0; channel < getTotalNumOutputChannels(); ++channel)
+        buffer.clear(channel, 0, numSamples);
+}
+
+template <typename SampleType>
+void DdxReverbAudioProcessor::delayDrySignal(juce::AudioBuffer<SampleType>& dry, int numSamples) noexcept
+{
+    // The lane networks run at host rate, so there is nothing to line up with
+    if (networkModeApplied != NetworkMode::mono)
+        return;
+
+    auto& delayLine = getDryDelayBuffer<SampleType>();
 
-    for (int c = 0; c < numCombs; ++c)
+    // A new delay starts from a clear line rather than whatever was left in it
+    const int targetDelay = resamplerLatency.load() + (pipelineApplied ? pipelineWorker->getLatencySamples() : 0);
+
+    if (targetDelay != dryDelaySamples)
     {
-        auto* combOut = combBuffer.getWritePointer(0);
-        combBuffer.clear();
+        dryDelaySamples = targetDelay;
+        delayLine.clear();
+    }
 
-        if (useSIMD)
-            combs[c].processBlockSIMD(monoData, combOut, numSamples);
-        else
-            combs[c].processBlockScalar(monoData, combOut, numSamples);
+    if (dryDelaySamples == 0)
+        return;
 
-        // Mix combs equally (parallel topology)
-        if (c == 0)
-            juce::FloatVectorOperations::copy(monoData, combOut, numSamples);
-        else
-            juce::FloatVectorOperations::add(monoData, combOut, numSamples);
+    const int lineLength = delayLine.getNumSamples();
+    const int numChannels = juce::jmin(dry.getNumChannels(), delayLine.getNumChannels());
+    int writePos = dryDelayWritePos;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = dry.getWritePointer(channel);
+        auto* line = delayLine.getWritePointer(channel);
+        writePos = dryDelayWritePos;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            int readPos = writePos - dryDelaySamples;
+            if (readPos < 0)
+                readPos += lineLength;
+
+            const auto delayed = line[readPos];
+            line[writePos] = data[i];
+            data[i] = delayed;
+
+            if (++writePos >= lineLength)
+                writePos = 0;
+        }
     }
 
-    // Scale down after parallel sum
-    juce::FloatVectorOperations::multiply(monoData, 0.25f, numSamples);
+    dryDelayWritePos = writePos;
+}
+
+void DdxReverbAudioProcessor::updateCpuGuard(int numSamples) noexcept
+{
+    smoothedCpuUsage += 0.1 * (cpuUsage - smoothedCpuUsage);
+    samplesSinceTierChange += numSamples;
 
-    // Process series all-passes for diffusion
-    // Diffusion: 0 = minimal, 20 = maximum
-    float apGain = juce::jmap(diffusion, 0.0f, 20.0f, 0.3f, 0.7f);
+    int newTier = qualityTier;
 
-    for (auto& ap : allpasses)
+    // A bounce has no deadline to protect, and must not depend on how busy the machine is
+    if (*apvts.getRawParameterValue("cpuguard") < 0.5f || isNonRealtime())
+    {
+        newTier = 0;
+    }
+    else
     {
-        ap.setGain(apGain);
+        const double budget = *apvts.getRawParameterValue("cpubudget") / 100.0;
+        const double heldSeconds = samplesSinceTierChange / currentSampleRate;
 
-        if (useSIMD)
-            ap.processBlockSIMD(monoData, monoData, numSamples);
-        else
-            ap.processBlockScalar(monoData, monoData, numSamples);
+        // Step down quickly when over budget, back up only after a sustained
+        // stretch well under it so the tiers do not oscillate
+        if (smoothedCpuUsage > budget && heldSeconds >= tierStepDownSeconds)
+            newTier = juce::jmin(qualityTier + 1, DdxReverbEngine::numQualityTiers - 1);
+        else if (smoothedCpuUsage < budget * tierRecoverRatio && heldSeconds >= tierStepUpSeconds)
+            newTier = juce::jmax(qualityTier - 1, 0);
     }
 
-    // Mix wet/dry (output to stereo with phase inversion for width)
-    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+    if (newTier != qualityTier)
     {
-        auto* outData = buffer.getWritePointer(channel);
-        auto* dryData = dryBuffer.getReadPointer(juce::jmin(channel, dryBuffer.getNumChannels() - 1));
+        qualityTier = newTier;
+        samplesSinceTierChange = 0;
+        ++qualityTierChanges;
+    }
+
+    reportedQualityTier = qualityTier;
+}
+
+void DdxReverbAudioProcessor::startEngineCrossfade(double seconds, bool isPresetSwitch) noexcept
+{
+    engineFadeRemaining = juce::jmax(1, static_cast<int>(currentSampleRate * seconds));
+    engineFadeGain = 0.0f;
+    fadeIsPresetSwitch = isPresetSwitch;
+}
 
-        // Dry signal (1 - wet)
-        juce::FloatVectorOperations::copy(outData, dryData, numSamples);
-        juce::FloatVectorOperations::multiply(outData, 1.0f - wetMix, numSamples);
+void DdxReverbAudioProcessor::applyEngineCrossfade(float* wetData, const float* outgoingData, int numSamples) noexcept
+{
+    // Ramp from wherever the gain is now, so the fade can be shortened mid-way
+    const float step = engineFadeRemaining > 0
+        ? (1.0f - engineFadeGain) / static_cast<float>(engineFadeRemaining)
+        : 1.0f;
 
-        // Add wet signal - STEREO WIDTH: invert right channel phase
-        if (channel == 1)
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (engineFadeRemaining > 0)
         {
-            // Right channel: invert phase for stereo width (DDX3216 style)
-            juce::FloatVectorOperations::addWithMultiply(outData, monoData, -wetMix, numSamples);
+            engineFadeGain += step;
+            --engineFadeRemaining;
         }
         else
         {
-            // Left channel: normal polarity
-            juce::FloatVectorOperations::addWithMultiply(outData, monoData, wetMix, numSamples);
+            engineFadeGain = 1.0f;
         }
+
+        wetData[i] = outgoingData[i] + engineFadeGain * (wetData[i] - outgoingData[i]);
     }
 
-    // Update CPU usage
-    auto endTime = juce::Time::getMillisecondCounterHiRes();
-    double blockTime = (endTime - startTime) / 1000.0; // seconds
-    double expectedBlockTime = static_cast<double>(numSamples) / currentSampleRate;
-    cpuUsage = blockTime / expectedBlockTime;
+    // Hand the finished engine to the builder thread to be recycled or freed
+    if (engineFadeRemaining == 0)
+    {
+        retiredEngine.store(fadingEngine.release());
+        presetFadeActive = false;
+    }
 }
 
 //==============================================================================
@@ -299,18 +2213,106 @@ juce::AudioProcessorEditor* DdxReverbAudioProcessor::createEditor()
 //==============================================================================
 void DdxReverbAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    const auto numValues = static_cast<juce::uint16>(stateValues.size());
+    destData.setSize(static_cast<size_t>(stateHeaderSize) + numValues * sizeof(float));
+
+    auto* dest = static_cast<char*>(destData.getData());
+    writeLittleEndian(dest, stateMagic);
+    writeLittleEndian(dest + 4, stateVersion);
+    writeLittleEndian(dest + 6, numValues);
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const float value = stateValues[i]->load();
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeLittleEndian(dest + stateHeaderSize + i * sizeof(float), bits);
+    }
 }
 
 void DdxReverbAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    if (setStateFromBinary(data, sizeInBytes))
+        return;
+
+    // Sessions saved before the binary format carry the APVTS as XML
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
     if (xmlState != nullptr)
         if (xmlState->hasTagName(apvts.state.getType()))
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+        {
+            auto state = juce::ValueTree::fromXml(*xmlState);
+            addMissingParameters(state);
+
+            // Flag first so the running engine still holds the old coefficients
+            presetSwitchPending = true;
+            apvts.replaceState(state);
+        }
+}
+
+bool DdxReverbAudioProcessor::setStateFromBinary(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes < stateHeaderSize)
+        return false;
+
+    auto* src = static_cast<const char*>(data);
+
+    if (juce::ByteOrder::littleEndianInt(src) != stateMagic)
+        return false;
+
+    const int version = juce::ByteOrder::littleEndianShort(src + 4);
+    const int numStored = juce::ByteOrder::littleEndianShort(src + 6);
+
+    if (version < 1 || sizeInBytes < stateHeaderSize + numStored * static_cast<int>(sizeof(float)))
+        return false;
+
+    // Loaded like an XML session: through replaceState, which only touches
+    // the parameters whose value actually changes
+    juce::ValueTree state(apvts.state.getType());
+    const int numValues = juce::jmin(numStored, static_cast<int>(stateParameters.size()));
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const juce::uint32 bits = juce::ByteOrder::littleEndianInt(src + stateHeaderSize + i * static_cast<int>(sizeof(float)));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        state.appendChild(juce::ValueTree(parameterNodeType, { { parameterIdProperty, stateParameterIDs[i] },
+                                                               { parameterValueProperty, value } }), nullptr);
+    }
+
+    addMissingParameters(state);
+
+    // Flag first so the running engine still holds the old coefficients
+    presetSwitchPending = true;
+    apvts.replaceState(state);
+
+    return true;
+}
+
+void DdxReverbAudioProcessor::addMissingParameters(juce::ValueTree& state) const
+{
+    // replaceState leaves a parameter the tree doesn't mention where it was,
+    // so a state from an older version would load differently into a
+    // modified instance than into a fresh one. Spell out the defaults, or the
+    // value that keeps such a state sounding the way it was saved.
+    for (size_t i = 0; i < stateParameters.size(); ++i)
+    {
+        const auto* id = stateParameterIDs[i];
+
+        if (state.getChildWithProperty(parameterIdProperty, id).isValid())
+            continue;
+
+        const auto* param = stateParameters[i];
+        float value = param->convertFrom0to1(param->getDefaultValue());
+
+        for (const auto& legacy : legacyParameterValues)
+            if (std::strcmp(legacy.id, id) == 0)
+                value = legacy.value;
+
+        state.appendChild(juce::ValueTree(parameterNodeType, { { parameterIdProperty, id },
+                                                               { parameterValueProperty, value } }), nullptr);
+    }
 }
 
 //==============================================================================
@@ -8,303 +8,20 @@
 
 #pragma once
 #include <JuceHeader.h>
-
-//==============================================================================
-// SHARC-style Feedback Comb Filter (Classic Schroeder Topology)
-// This is the CORRECT implementation used in vintage digital reverbs
-//==============================================================================
-class SharcCombFilter
-{
-public:
-    SharcCombFilter() = default;
-
-    void prepare(double sRate, int maxDelaySamples, float initialGain = 0.7f, float dampingFreq = 5000.0f)
-    {
-        delayLine.resize(maxDelaySamples);
-        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-        writeIndex = 0;
-        this->delaySamples = juce::jlimit(1, maxDelaySamples, maxDelaySamples);
-        this->feedbackGain = initialGain;
-        this->sRate = sRate;
-
-        // Damping filter (one-pole lowpass in feedback path)
-        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * dampingFreq / (float)sRate);
-        filterState = 0.0f;
-        prepared = true;
-    }
-
-    void setDelaySamples(int newDelay)
-    {
-        delaySamples = juce::jlimit(1, (int)delayLine.size(), newDelay);
-    }
-
-    void setGain(float newGain)
-    {
-        feedbackGain = juce::jlimit(0.0f, 0.99f, newGain);
-    }
-
-    void setDampingFreq(float freq)
-    {
-        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * freq / (float)sRate);
-    }
-
-    void reset()
-    {
-        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-        writeIndex = 0;
-        filterState = 0.0f;
-    }
-
-    // Scalar version - CORRECT feedback comb topology
-    // Read old delayed sample FIRST, then write new sample
-    void processBlockScalar(const float* input, float* output, int numSamples) noexcept
-    {
-        if (!prepared) return;
-
-        auto* buffer = delayLine.data();
-        int idx = writeIndex;
-        const int len = delaySamples;
-        const float g = feedbackGain;
-        const float damp = dampingCoeff;
-        float flt = filterState;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            // 1. READ old delayed sample
-            float delayed = buffer[idx];
-
-            // 2. Apply one-pole lowpass damping to feedback
-            flt = delayed + damp * (flt - delayed);
-
-            // 3. FEEDBACK comb: new sample = input + g * dampedFeedback
-            float newSample = input[i] + g * flt;
-
-            // 4. WRITE new sample to buffer
-            buffer[idx] = newSample;
-
-            // 5. OUTPUT is the delayed sample (or mix with input)
-            output[i] = newSample;
-
-            // 6. Advance circular buffer
-            if (++idx >= len) idx = 0;
-        }
-
-        writeIndex = idx;
-        filterState = flt;
-    }
-
-    // SIMD version - same algorithm, vectorized
-    void processBlockSIMD(const float* input, float* output, int numSamples) noexcept
-    {
-        if (!prepared) return;
-
-        using SIMD = juce::dsp::SIMDRegister<float>;
-        constexpr size_t simdWidth = SIMD::SIMDRegister::size();
-
-        auto* buffer = delayLine.data();
-        int idx = writeIndex;
-        const int len = delaySamples;
-        const float g = feedbackGain;
-        const float damp = dampingCoeff;
-        float flt = filterState;
-
-        size_t vectorSamples = (static_cast<size_t>(numSamples) / simdWidth) * simdWidth;
-
-        // SIMD main loop
-        for (size_t i = 0; i < vectorSamples; i += simdWidth)
-        {
-            alignas(32) float delayed[8] = { 0 }; // Max SIMD width
-            for (size_t j = 0; j < simdWidth; ++j)
-                delayed[j] = buffer[(idx + static_cast<int>(j)) % len];
-
-            SIMD delayedVec = SIMD::fromRawArray(delayed);
-            SIMD inputVec = SIMD::fromRawArray(input + i);
-
-            // Apply damping (simplified - per-sample would be more accurate)
-            alignas(32) float dampedVals[8] = { 0 };
-            for (size_t j = 0; j < simdWidth; ++j)
-            {
-                flt = delayed[j] + damp * (flt - delayed[j]);
-                dampedVals[j] = flt;
-            }
-
-            SIMD dampedVec = SIMD::fromRawArray(dampedVals);
-            SIMD gVec(g);
-            SIMD outVec = inputVec + gVec * dampedVec; // Fixed: proper SIMD multiplication
-
-            outVec.copyToRawArray(output + i);
-
-            // Store back to buffer
-            alignas(32) float toStore[8] = { 0 };
-            outVec.copyToRawArray(toStore);
-            for (size_t j = 0; j < simdWidth; ++j)
-                buffer[(idx + static_cast<int>(j)) % len] = toStore[j];
-
-            idx = (idx + static_cast<int>(simdWidth)) % len;
-        }
-
-        // Scalar tail
-        for (int i = static_cast<int>(vectorSamples); i < numSamples; ++i)
-        {
-            float delayed = buffer[idx];
-            flt = delayed + damp * (flt - delayed);
-            float newSample = input[i] + g * flt;
-            buffer[idx] = newSample;
-            output[i] = newSample;
-            if (++idx >= len) idx = 0;
-        }
-
-        writeIndex = idx;
-        filterState = flt;
-    }
-
-private:
-    std::vector<float> delayLine;
-    int delaySamples = 1000;
-    int writeIndex = 0;
-    float feedbackGain = 0.7f;
-    float dampingCoeff = 0.5f;
-    float filterState = 0.0f;
-    double sRate = 48000.0;
-    bool prepared = false;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharcCombFilter)
-};
-
-//==============================================================================
-// SHARC-style All-Pass Filter (Classic Schroeder topology)
-// Formula: y[n] = -g*x[n] + x[n-M] + g*y[n-M]
-//==============================================================================
-class SharcAllpassFilter
-{
-public:
-    SharcAllpassFilter() = default;
-
-    void prepare(double /*sampleRate*/, int maxDelaySamples, float initialGain = 0.5f)
-    {
-        delayLine.resize(maxDelaySamples);
-        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-        writeIndex = 0;
-        this->delaySamples = juce::jlimit(1, maxDelaySamples, maxDelaySamples);
-        this->apGain = initialGain;
-        prepared = true;
-    }
-
-    void setDelaySamples(int newDelay)
-    {
-        delaySamples = juce::jlimit(1, (int)delayLine.size(), newDelay);
-    }
-
-    void setGain(float newGain)
-    {
-        apGain = juce::jlimit(-0.99f, 0.99f, newGain);
-    }
-
-    void reset()
-    {
-        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-        writeIndex = 0;
-    }
-
-    // Scalar version - exact SHARC all-pass
-    // CRITICAL: Read delayed sample FIRST, then write new value
-    void processBlockScalar(const float* input, float* output, int numSamples) noexcept
-    {
-        if (!prepared) return;
-
-        auto* buffer = delayLine.data();
-        int idx = writeIndex;
-        const int len = delaySamples;
-        const float g = apGain;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            // 1. READ old delayed sample
-            float delayed = buffer[idx];
-
-            // 2. Calculate output: y[n] = -g*x[n] + x[n-M] + g*y[n-M]
-            //    Simplified: out = -g*input + delayed (since delayed already contains x[n-M] + g*y[n-M-M])
-            float out = -g * input[i] + delayed;
-
-            // 3. WRITE new value: x[n] + g*y[n-M]
-            buffer[idx] = input[i] + delayed * g;
-
-            // 4. Output result
-            output[i] = out;
-
-            // 5. Advance circular buffer
-            if (++idx >= len) idx = 0;
-        }
-
-        writeIndex = idx;
-    }
-
-    // SIMD version
-    void processBlockSIMD(const float* input, float* output, int numSamples) noexcept
-    {
-        if (!prepared) return;
-
-        using SIMD = juce::dsp::SIMDRegister<float>;
-        constexpr size_t simdWidth = SIMD::SIMDRegister::size();
-
-        auto* buffer = delayLine.data();
-        int idx = writeIndex;
-        const int len = delaySamples;
-        const float g = apGain;
-
-        size_t vectorSamples = (static_cast<size_t>(numSamples) / simdWidth) * simdWidth;
-
-        // SIMD main loop
-        for (size_t i = 0; i < vectorSamples; i += simdWidth)
-        {
-            alignas(32) float delayed[8] = { 0 };
-            for (size_t j = 0; j < simdWidth; ++j)
-                delayed[j] = buffer[(idx + static_cast<int>(j)) % len];
-
-            SIMD delayedVec = SIMD::fromRawArray(delayed);
-            SIMD inputVec = SIMD::fromRawArray(input + i);
-            SIMD gVec(g);
-
-            SIMD outVec = gVec * inputVec * (-1.0f) + delayedVec; // Fixed: proper SIMD ops
-            outVec.copyToRawArray(output + i);
-
-            // Store new values
-            SIMD newVals = inputVec + gVec * delayedVec; // Fixed: proper SIMD multiplication
-            alignas(32) float toStore[8] = { 0 };
-            newVals.copyToRawArray(toStore);
-            for (size_t j = 0; j < simdWidth; ++j)
-                buffer[(idx + static_cast<int>(j)) % len] = toStore[j];
-
-            idx = (idx + static_cast<int>(simdWidth)) % len;
-        }
-
-        // Scalar tail
-        for (int i = static_cast<int>(vectorSamples); i < numSamples; ++i)
-        {
-            float delayed = buffer[idx];
-            float out = -g * input[i] + delayed;
-            buffer[idx] = input[i] + delayed * g;
-            output[i] = out;
-            if (++idx >= len) idx = 0;
-        }
-
-        writeIndex = idx;
-    }
-
-private:
-    std::vector<float> delayLine;
-    int delaySamples = 500;
-    int writeIndex = 0;
-    float apGain = 0.5f;
-    bool prepared = false;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharcAllpassFilter)
-};
+#include "ReverbEngine.h"
+#include "MixedPrecision.h"
+#include "InputFilterBank.h"
+#include "TailEnergyTracker.h"
+#include "PolyphaseResampler.h"
+#include "LaneReverbNetwork.h"
+#include "TelemetryChannel.h"
+#include "SharedAudioRing.h"
 
 //==============================================================================
 // Main Plugin Processor
 //==============================================================================
-class DdxReverbAudioProcessor : public juce::AudioProcessor
+class DdxReverbAudioProcessor : public juce::AudioProcessor,
+    private juce::AsyncUpdater
 {
 public:
     DdxReverbAudioProcessor();
@@ -312,8 +29,11 @@ public:
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -322,7 +42,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 20.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -335,37 +55,328 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // CPU monitoring
-    float getCpuUsage() const { return static_cast<float>(cpuUsage); }
+    // One block's worth of monitoring values, published by the audio thread
+    struct Telemetry
+    {
+        float cpuUsage = 0.0f;     // block time / real time
+        float fadeCpuUsage = 0.0f; // outgoing engine's share during a crossfade
+        int blockSize = 0;
+        double sampleRate = 0.0;   // host rate
+        ReverbAlgorithm algorithm = ReverbAlgorithm::sharc;
+        bool simd = false;
+        bool pipelined = false;
+        bool doublePrecision = false;  // host calls the 64-bit processBlock
+        bool wideAccumulation = false; // engine sums in double
+        bool asleep = false;
+        int qualityTier = 0;
+        int pipelineUnderruns = 0;
+        float remoteOverheadMicroseconds = 0.0f; // 0 unless out-of-process
+        bool remoteLagging = false; // engine process late, blocks running in-process meanwhile
+        float inputPeak = 0.0f;    // network input
+        float wetPeak = 0.0f;      // network output
+        float outputPeak = 0.0f;   // main output bus
+    };
+
+    // Editor side - publishing is skipped while no editor has it enabled.
+    // readTelemetry() must only be called from the message thread.
+    void setTelemetryEnabled(bool shouldBeEnabled) noexcept { telemetryEnabled = shouldBeEnabled; }
+    const Telemetry& readTelemetry() noexcept { return telemetry.read(); }
+
+    // Audio thread only
+    bool isNetworkAsleep() const { return tailTracker.isAsleep(); }
+
+    // Smoothed cost of the mono network per host sample, by algorithm
+    // (0 until that algorithm has run, or if the CPU clock is unknown)
+    float getNetworkCyclesPerSample(ReverbAlgorithm algorithm) const
+    {
+        return networkCyclesPerSample[static_cast<size_t>(algorithm)].load();
+    }
 
-private:
-    static constexpr int numCombs = 4;
-    static constexpr int numAllpasses = 8;
+    // True stereo, quad or surround: the lane-packed network, which follows
+    // the program but has no algorithm, early, modulation or Bass Multiply
+    bool isLaneModeActive() const noexcept;
+
+    // CPU guard state (0 = full quality)
+    int getQualityTier() const { return reportedQualityTier.load(); }
+    int getQualityTierChanges() const { return qualityTierChanges.load(); }
+
+    // Instantiation / transport-start cost
+    double getConstructionTimeMs() const { return constructionTimeMs; }
+    double getLastPrepareTimeMs() const { return lastPrepareTimeMs; }
+
+    // Lets a plugin format hand over the host's worker threads (CLAP
+    // thread-pool). Set it before prepareToPlay; null to go back.
+    void setHostTaskPool(RenderTaskPool* pool) noexcept;
 
-    // Prime-number delays at 48kHz (classic Schroeder approach)
-    static const int combDelays[numCombs];
-    static const int allpassDelays[numAllpasses];
+    // Out-of-process engine side: the engine host marks its processor so it
+    // never launches an engine of its own, then feeds it each slot's values
+    // (raw, in binary state order)
+    void markAsEngineProcess() noexcept { isEngineProcess = true; }
+    int getNumStateParameters() const noexcept { return static_cast<int>(stateValues.size()); }
+    void setParameterValues(const float* values, int numValues) noexcept;
+    bool isRemoteEngineActive() const noexcept { return remoteReady.load(); }
+
+    // Builds a replacement engine for the given spec on the background thread.
+    // Use this for anything that needs new delay memory (sample rate, room size).
+    void requestEngineRebuild(const ReverbEngineSpec& spec);
+
+private:
+    class EngineBuilder;
+    class PipelineWorker;
+    class RemoteEngineClient;
 
     juce::AudioProcessorValueTreeState apvts;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    std::array<SharcCombFilter, numCombs> combs;
-    std::array<SharcAllpassFilter, numAllpasses> allpasses;
-
-    // Pre-delay line
-    std::vector<float> preDelayBuffer;
-    int preDelayWritePos = 0;
-    int preDelaySamples = 0;
+    bool setStateFromBinary(const void* data, int sizeInBytes);
+    void addMissingParameters(juce::ValueTree& state) const;
+
+    // Parameters in binary state order, resolved once in the constructor
+    std::vector<juce::RangedAudioParameter*> stateParameters;
+    std::vector<std::atomic<float>*> stateValues;
+
+    // Both precisions share one body. The network itself always runs in
+    // float; with double buffers only the dry path and final mix stay wide.
+    template <typename SampleType>
+    void processBlockImpl(juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    template <typename SampleType>
+    void processLocalBlock(juce::AudioBuffer<SampleType>& buffer, double startTime) noexcept;
+
+    // Network inputs as float channels: a float block's own channels, or a
+    // double block narrowed into networkInputBuffer
+    template <typename SampleType>
+    float* const* getNetworkInputs(juce::AudioBuffer<SampleType>& buffer, int numChannels, int numSamples) noexcept;
+
+    void updateCpuGuard(int numSamples) noexcept;
+
+    template <typename SampleType>
+    void publishTelemetry(const juce::AudioBuffer<SampleType>& buffer, int numSamples, float inputPeak, float wetPeak) noexcept;
+
+    // Internal-rate mode: the network runs at host rate / factor
+    int getInternalRateFactor() const;
+    int getReportedLatency(int factor) const;
+    void handleAsyncUpdate() override;
+    void setEngineTarget(const ReverbEngineSpec& spec, bool rebuildActive);
+    void syncResampler(PolyphaseResampler& resampler, const DdxReverbEngine& engine) noexcept;
+    double processMonoNetwork(float* monoData, int numSamples, float decayTime, float predelayMs,
+                              float dampingPct, float diffusion, float bassMult) noexcept;
+    void processWetPath(DdxReverbEngine& engine, PolyphaseResampler& resampler, float* data, int numSamples) noexcept;
+    template <typename SampleType>
+    void delayDrySignal(juce::AudioBuffer<SampleType>& dry, int numSamples) noexcept;
+    // Early-reflection pattern the parameters ask for (Auto resolved)
+    EarlyPattern getEarlyPattern(ReverbAlgorithm algorithm, ReverbProgram program) const noexcept;
+
+    // Marks the current algorithm/program/early/modulation as applied
+    void syncAppliedPreset() noexcept;
+
+    void updateNetworkCycles(ReverbAlgorithm algorithm, double networkTimeMs, int numSamples) noexcept;
+
+    // Pipelined mode: the mono network runs on PipelineWorker one block behind
+    bool isPipelineRequested() const noexcept;
+    void processPipelinedBlock(float* monoData, int numSamples) noexcept;
+
+    // Independent parts of a block run on the pool, joined before
+    // processBlock returns. Null when there is nothing to run them on.
+    RenderTaskPool* getTaskPool(int numSamples) const noexcept;
+
+    // Out-of-process mode - launch/stop on the message thread only
+    bool isRemoteRequested() const noexcept;
+    static juce::File getRemoteEngineExecutable();
+    void updateRemoteEngine(double sampleRate, int maxBlockSize);
+    bool processRemoteBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+    void processRemoteOrLocalBlock(juce::AudioBuffer<float>& buffer, int numSamples, double startTime) noexcept;
+
+    // Aux-send mode
+    template <typename SampleType>
+    void sumSendInputs(juce::AudioBuffer<SampleType>& buffer, float* monoData, int numSamples) noexcept;
+
+    template <typename SampleType>
+    void clearOutputs(juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept;
+
+    // Lane-packed modes (true stereo, quad, surround) - only one runs at a time
+    enum class NetworkMode { mono, stereo, quad, surround };
+    NetworkMode getNetworkMode(bool quadMode, bool stereoMode) const noexcept;
+    void setupLaneNetworks(NetworkMode mode) noexcept;
+    void setLaneParameters(int lane, float decayTime, float predelayMs, float dampingPct, float diffusion) noexcept;
+    void processLanes(int numLanes, int numSamples) noexcept;
+    float getLaneStatePeak() const noexcept;
+
+    void processQuadBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+    void processSurroundBlock(juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+
+    void startEngineCrossfade(double seconds, bool isPresetSwitch) noexcept;
+    void applyEngineCrossfade(float* wetData, const float* outgoingData, int numSamples) noexcept;
+
+    // Engine double-buffering: the audio thread owns active/fading (the
+    // pipeline worker does while pipelineApplied is set), the builder thread
+    // fills pendingEngine/spareEngine and recycles or frees whatever lands in
+    // retiredEngine. enginePrepared is what other threads may look at.
+    std::unique_ptr<DdxReverbEngine> activeEngine;
+    std::atomic<bool> enginePrepared { false };
+    std::unique_ptr<DdxReverbEngine> fadingEngine;
+    std::atomic<DdxReverbEngine*> pendingEngine { nullptr };
+    std::atomic<DdxReverbEngine*> spareEngine { nullptr };
+    std::atomic<DdxReverbEngine*> retiredEngine { nullptr };
+    std::unique_ptr<EngineBuilder> engineBuilder;
+
+    // Spec the engines should match - message thread and prepareToPlay only.
+    // The audio thread only sees its generation, which each built engine carries.
+    ReverbEngineSpec targetEngineSpec;
+    std::atomic<juce::uint32> wantedEngineGeneration { 0 };
+
+    // Short crossfade from the outgoing engine's tail into the new one
+    static constexpr double engineFadeSeconds = 0.02;
+    int engineFadeRemaining = 0;
+    float engineFadeGain = 1.0f;
+
+    // Preset switching runs the spare engine only for the "xfade" window
+    std::atomic<bool> presetSwitchPending { false };
+    std::atomic<bool> presetFadeActive { false };
+    bool fadeIsPresetSwitch = false;
+
+    // Share of the block the outgoing engine may use before the fade is shortened
+    static constexpr double maxFadeCpuUsage = 0.25;
+
+    // Resamplers around the wet path, one per engine so a crossfade between
+    // different internal rates keeps both histories; index follows activeEngine
+    std::array<PolyphaseResampler, 2> wetResamplers;
+    int activeResampler = 0;
+    bool internalRateApplied = false;
+    NetworkMode networkModeApplied = NetworkMode::mono;
+    ReverbAlgorithm algorithmApplied = ReverbAlgorithm::sharc;
+    ReverbProgram programApplied = ReverbProgram::cathedral;
+    EarlyPattern earlyPatternApplied = EarlyPattern::cathedral;
+    DelayModulation modulationApplied = DelayModulation::off;
+
+    // Dry path delayed by the wet path's latency so the host can compensate.
+    // The resampler part is published by whichever thread runs the network.
+    juce::AudioBuffer<float> dryDelayBuffer;
+    juce::AudioBuffer<double> dryDelayBufferDouble;
+    int dryDelayWritePos = 0;
+    int dryDelaySamples = 0;
+    std::atomic<int> resamplerLatency { 0 };
+
+    // Worker thread that owns the mono network while pipelineApplied is set
+    std::unique_ptr<PipelineWorker> pipelineWorker;
+    std::atomic<bool> pipelineApplied { false };
+
+    // Engine process and shared ring for out-of-process mode
+    std::unique_ptr<RemoteEngineClient> remoteEngine;
+    std::atomic<bool> remoteReady { false };
+    std::atomic<bool> remoteInUse { false };
+    std::atomic<int> remoteFailures { 0 };
+    static constexpr int maxRemoteFailures = 3;
+    bool remoteApplied = false;
+    bool isEngineProcess = false;
+    float remoteOverheadMicroseconds = 0.0f;
+    bool remoteLagging = false;
+
+    // Crossfades between the engine process and the in-process engine:
+    // the last block the engine returned (remoteFadeSamples long, 0 if that
+    // block ran here) and the input copy a block coming back runs on here
+    juce::AudioBuffer<float> remoteFadeBuffer;
+    juce::AudioBuffer<float> localFadeBuffer;
+    int remoteFadeSamples = 0;
+
+    // Created by the first offline prepare
+    std::unique_ptr<OfflineRenderPool> offlinePool;
+    RenderTaskPool* hostTaskPool = nullptr;
+
+    // Quad mode - four independent engines packed into SIMD lanes, each fed
+    // by input bus N and mixed onto output bus N
+    static constexpr int numQuadEngines = 4;
+
+    struct QuadEngineParameters
+    {
+        std::atomic<float>* decay = nullptr;
+        std::atomic<float>* predelay = nullptr;
+        std::atomic<float>* damping = nullptr;
+        std::atomic<float>* diffusion = nullptr;
+        std::atomic<float>* hicut = nullptr;
+        std::atomic<float>* lowcut = nullptr;
+        std::atomic<float>* wet = nullptr;
+    };
+
+    std::array<QuadEngineParameters, numQuadEngines> quadParameters;
+    InputFilterBank quadFilters;
+    juce::AudioBuffer<float> quadDryBuffer;
+
+    // Lane-packed networks shared by the lane modes, with enough lanes for
+    // 7.1 (one network on AVX, two on SSE/NEON). laneBuffer holds one
+    // channel per lane and is processed in place.
+    static constexpr int maxSurroundChannels = 8;
+    static constexpr int numLaneNetworks = (maxSurroundChannels + LaneReverbNetwork::maxLanes - 1) / LaneReverbNetwork::maxLanes;
+    static_assert(numLaneNetworks * LaneReverbNetwork::maxLanes >= numQuadEngines, "one engine per lane");
+
+    std::array<LaneReverbNetwork, numLaneNetworks> laneNetworks;
+    juce::AudioBuffer<float> laneBuffer;
+
+    // Per-lane delay offsets in samples at 48kHz, so the outputs decorrelate.
+    // True stereo offsets the right lane; surround gives every channel its own.
+    static constexpr int stereoSpread = 23;
+    static constexpr int surroundSpreads[maxSurroundChannels] = { 0, 23, 41, 59, 73, 89, 107, 127 };
+
+    // Per-instance input filtering (replaces the old shared static hi-cut state)
+    InputFilterBank inputFilters;
+
+    // CPU guard - tier changes are crossfaded inside the engine
+    static constexpr double tierStepDownSeconds = 0.1;
+    static constexpr double tierStepUpSeconds = 2.0;
+    static constexpr double tierRecoverRatio = 0.6;
+    int qualityTier = 0;
+    juce::int64 samplesSinceTierChange = 0;
+    double smoothedCpuUsage = 0.0;
+    std::atomic<int> reportedQualityTier { 0 };
+    std::atomic<int> qualityTierChanges { 0 };
+
+    // Suspends the network once the tail has decayed
+    TailEnergyTracker tailTracker;
 
     // Dry/wet buffers
     juce::AudioBuffer<float> dryBuffer;
     juce::AudioBuffer<float> tempBuffer;
+    juce::AudioBuffer<float> fadeBuffer;
+    juce::AudioBuffer<float> internalBuffer;
+
+    // Double-precision hosts: the dry path at full width, the filtered
+    // network inputs in float, and a float copy of the whole block for the
+    // modes that only run in float (lanes, out-of-process)
+    juce::AudioBuffer<double> dryBufferDouble;
+    juce::AudioBuffer<float> networkInputBuffer;
+    juce::AudioBuffer<float> precisionBuffer;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getDryBuffer() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return dryBufferDouble;
+        else
+            return dryBuffer;
+    }
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getDryDelayBuffer() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return dryDelayBufferDouble;
+        else
+            return dryDelayBuffer;
+    }
 
-    double currentSampleRate = 48000.0;
-    bool useSIMD = false;
+    double currentSampleRate = 48000.0; // host rate
+    std::atomic<bool> useSIMD { false }; // also read by the pipeline worker
 
     // CPU monitoring
     double cpuUsage = 0.0;
+    double fadeCpuUsage = 0.0;
+    double constructionTimeMs = 0.0;
+    double lastPrepareTimeMs = 0.0;
+    int cpuSpeedMHz = 0;
+    std::array<std::atomic<float>, numReverbAlgorithms> networkCyclesPerSample {};
+
+    TelemetryChannel<Telemetry> telemetry;
+    std::atomic<bool> telemetryEnabled { false };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DdxReverbAudioProcessor)
 };
\ No newline at end of file
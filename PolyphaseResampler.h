@@ -0,0 +1,236 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Polyphase Resampler
+  JUCE 8.0.11
+
+  Integer-factor decimator/interpolator pair that lets the wet network run
+  at the DDX3216's own 44.1/48 kHz while the host runs at 88.2-192 kHz.
+  Both sides are polyphase: every SIMD lane holds one phase of the same
+  windowed-sinc lowpass, so one multiply-add per tap covers a whole frame
+  of `factor` host samples. All tables are fixed size - nothing allocates.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Polyphase Resampler - host rate -> host/factor -> host rate
+//==============================================================================
+class PolyphaseResampler
+{
+public:
+    using SIMD = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxFactor = 4;
+    static constexpr int tapsPerPhase = 16;
+
+    static_assert(static_cast<int>(SIMD::size()) >= maxFactor, "one phase per SIMD lane");
+
+    // Lowest internal rate the network is allowed to drop to
+    static constexpr double minInternalRate = 44100.0;
+
+    PolyphaseResampler()
+    {
+        for (int f = 2; f <= maxFactor; ++f)
+            designTaps(f);
+
+        setFactor(1);
+    }
+
+    // Largest power-of-two factor that keeps the network at 44.1 kHz or above
+    static int getFactorFor(double hostRate) noexcept
+    {
+        int factor = 1;
+
+        while (factor * 2 <= maxFactor && hostRate / (factor * 2) >= minInternalRate - 1.0)
+            factor *= 2;
+
+        return factor;
+    }
+
+    // Decimation and interpolation filters are each tapsPerPhase * factor long
+    // and linear phase, plus one host sample of hand-over between the two
+    static int getLatencyFor(int factor) noexcept
+    {
+        return factor > 1 ? tapsPerPhase * factor : 0;
+    }
+
+    static constexpr int maxLatency = tapsPerPhase * maxFactor;
+
+    // Switches factor and clears all history
+    void setFactor(int newFactor) noexcept
+    {
+        factor = juce::jlimit(1, maxFactor, newFactor);
+        reset();
+    }
+
+    int getFactor() const noexcept { return factor; }
+    int getLatencySamples() const noexcept { return getLatencyFor(factor); }
+
+    void reset() noexcept
+    {
+        std::fill(std::begin(decimHistory), std::end(decimHistory), SIMD(0.0f));
+        std::fill(std::begin(interpHistory), std::end(interpHistory), 0.0f);
+        std::fill(std::begin(inFrame), std::end(inFrame), 0.0f);
+        std::fill(std::begin(outFrame), std::end(outFrame), 0.0f);
+
+        decimWritePos = interpWritePos = 0;
+        decimPhase = interpPhase = 0;
+
+        // The first interpolated frame has nothing decimated before it yet
+        carry = 0.0f;
+        hasCarry = true;
+    }
+
+    // Low-passes and decimates a host-rate block; returns the number of
+    // internal-rate samples written (block sizes need not divide by factor)
+    int decimate(const float* input, int numSamples, float* internal) noexcept
+    {
+        const auto& taps = decimTaps[static_cast<size_t>(factor)];
+        int numInternal = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            inFrame[decimPhase] = input[i];
+
+            if (++decimPhase < factor)
+                continue;
+
+            decimPhase = 0;
+
+            // Lane p of a frame is host sample factor*m + p
+            const auto frame = SIMD::fromRawArray(inFrame);
+            decimHistory[decimWritePos] = frame;
+            decimHistory[decimWritePos + tapsPerPhase] = frame;
+
+            SIMD acc(0.0f);
+            const int newest = decimWritePos + tapsPerPhase;
+
+            for (int k = 0; k < tapsPerPhase; ++k)
+                acc += taps[static_cast<size_t>(k)] * decimHistory[newest - k];
+
+            internal[numInternal++] = acc.sum();
+
+            if (++decimWritePos >= tapsPerPhase)
+                decimWritePos = 0;
+        }
+
+        return numInternal;
+    }
+
+    // Interpolates the processed internal block back to numSamples host-rate
+    // samples. Each internal sample is used one host sample after decimate()
+    // produced it, so a sample made on the last host sample is carried over.
+    void interpolate(const float* internal, int numInternal, float* output, int numSamples) noexcept
+    {
+        const auto& taps = interpTaps[static_cast<size_t>(factor)];
+        int readIndex = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (interpPhase == 0)
+            {
+                float next = carry;
+
+                if (hasCarry)
+                    hasCarry = false;
+                else
+                    next = internal[readIndex++];
+
+                interpHistory[interpWritePos] = next;
+                interpHistory[interpWritePos + tapsPerPhase] = next;
+
+                // All `factor` output phases at once, one per lane
+                SIMD acc(0.0f);
+                const int newest = interpWritePos + tapsPerPhase;
+
+                for (int k = 0; k < tapsPerPhase; ++k)
+                    acc += taps[static_cast<size_t>(k)] * SIMD(interpHistory[newest - k]);
+
+                acc.copyToRawArray(outFrame);
+
+                if (++interpWritePos >= tapsPerPhase)
+                    interpWritePos = 0;
+            }
+
+            output[i] = outFrame[interpPhase];
+
+            if (++interpPhase >= factor)
+                interpPhase = 0;
+        }
+
+        jassert(readIndex <= numInternal);
+
+        if (readIndex < numInternal)
+        {
+            jassert(readIndex + 1 == numInternal);
+            carry = internal[readIndex];
+            hasCarry = true;
+        }
+    }
+
+private:
+    using TapTable = std::array<SIMD, tapsPerPhase>;
+
+    // Blackman-windowed sinc cut at 90% of the internal Nyquist, split into
+    // one polyphase branch per lane
+    void designTaps(int f)
+    {
+        const int length = tapsPerPhase * f;
+        const double cutoff = 0.45 / f; // cycles per host sample
+        const double centre = (length - 1) * 0.5;
+
+        double h[tapsPerPhase * maxFactor] = {};
+        double sum = 0.0;
+
+        for (int n = 0; n < length; ++n)
+        {
+            const double x = n - centre;
+            const double sinc = x == 0.0 ? 2.0 * cutoff
+                                         : std::sin(juce::MathConstants<double>::twoPi * cutoff * x) / (juce::MathConstants<double>::pi * x);
+            const double phase = juce::MathConstants<double>::twoPi * n / (length - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            h[n] = sinc * window;
+            sum += h[n];
+        }
+
+        for (int k = 0; k < tapsPerPhase; ++k)
+        {
+            alignas(32) float decim[SIMD::size()] = {};
+            alignas(32) float interp[SIMD::size()] = {};
+
+            for (int p = 0; p < f; ++p)
+            {
+                // Newest lane of a frame meets the first tap of its branch
+                decim[p] = static_cast<float>(h[k * f + (f - 1 - p)] / sum);
+
+                // Zero-stuffing drops the level by the factor, so make it up here
+                interp[p] = static_cast<float>(f * h[k * f + p] / sum);
+            }
+
+            decimTaps[static_cast<size_t>(f)][static_cast<size_t>(k)] = SIMD::fromRawArray(decim);
+            interpTaps[static_cast<size_t>(f)][static_cast<size_t>(k)] = SIMD::fromRawArray(interp);
+        }
+    }
+
+    int factor = 1;
+
+    std::array<TapTable, maxFactor + 1> decimTaps {};
+    std::array<TapTable, maxFactor + 1> interpTaps {};
+
+    // Doubled rings so the newest tapsPerPhase entries are always contiguous
+    SIMD decimHistory[2 * tapsPerPhase];
+    float interpHistory[2 * tapsPerPhase] = {};
+    int decimWritePos = 0;
+    int interpWritePos = 0;
+
+    alignas(32) float inFrame[SIMD::size()] = {};
+    alignas(32) float outFrame[SIMD::size()] = {};
+    int decimPhase = 0;
+    int interpPhase = 0;
+
+    float carry = 0.0f;
+    bool hasCarry = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseResampler)
+};
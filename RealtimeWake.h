@@ -0,0 +1,119 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Realtime Wake
+  JUCE 8.0.11
+
+  Wakes a sleeping worker thread without taking a lock, so the audio
+  thread can hand work over (juce::Thread::notify goes through a
+  WaitableEvent and its mutex). The waiter announces that it is about to
+  sleep; signal() only makes the wake call when it has, so a busy worker
+  costs the signalling side two atomic operations and nothing else - the
+  same scheme SharedAudioRing uses across processes.
+
+  The sleep is a futex on Linux, WaitOnAddress on Windows and a dispatch
+  semaphore on macOS/iOS. Elsewhere the waiter just polls every
+  millisecond. A wake may come early or spuriously, so the waiter always
+  re-checks its own work after wait() returns.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <climits>
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+ #if JUCE_MSVC
+  #pragma comment(lib, "Synchronization.lib")
+ #endif
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#endif
+
+//==============================================================================
+// Realtime Wake - one waiter, any number of signallers
+//==============================================================================
+class RealtimeWake
+{
+public:
+    RealtimeWake()
+    {
+       #if JUCE_MAC || JUCE_IOS
+        semaphore = dispatch_semaphore_create(0);
+       #endif
+    }
+
+    ~RealtimeWake()
+    {
+       #if JUCE_MAC || JUCE_IOS
+        dispatch_release(semaphore);
+       #endif
+    }
+
+    // Any thread, never blocks or locks
+    void signal() noexcept
+    {
+        pending.store(1);
+
+        if (waiting.load() != 0)
+            wake();
+    }
+
+    // Waiting thread only: returns once signalled or after timeoutMs
+    void wait(int timeoutMs) noexcept
+    {
+        waiting.store(1);
+
+        // A signal that came in before the announcement is already pending
+        if (pending.load() == 0)
+            sleep(timeoutMs);
+
+        waiting.store(0);
+        pending.store(0);
+    }
+
+private:
+    void sleep(int timeoutMs) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        timespec timeout { static_cast<time_t>(timeoutMs / 1000), static_cast<long>((timeoutMs % 1000) * 1000000) };
+        ::syscall(SYS_futex, reinterpret_cast<juce::uint32*>(&pending), FUTEX_WAIT_PRIVATE, 0, &timeout, nullptr, 0);
+       #elif JUCE_WINDOWS
+        juce::uint32 expected = 0;
+        ::WaitOnAddress(&pending, &expected, sizeof(expected), static_cast<DWORD>(timeoutMs));
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(timeoutMs) * NSEC_PER_MSEC));
+       #else
+        for (int elapsedMs = 0; elapsedMs < timeoutMs && pending.load() == 0; ++elapsedMs)
+            juce::Thread::sleep(1);
+       #endif
+    }
+
+    void wake() noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        ::syscall(SYS_futex, reinterpret_cast<juce::uint32*>(&pending), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+       #elif JUCE_WINDOWS
+        ::WakeByAddressSingle(&pending);
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_signal(semaphore);
+       #endif
+    }
+
+    std::atomic<juce::uint32> pending { 0 };  // futex word
+    std::atomic<juce::uint32> waiting { 0 };
+
+   #if JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t semaphore;
+   #endif
+
+    static_assert(sizeof(std::atomic<juce::uint32>) == sizeof(juce::uint32)
+                  && std::atomic<juce::uint32>::is_always_lock_free, "futex words must be plain 32-bit");
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeWake)
+};
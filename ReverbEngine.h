@@ -0,0 +1,873 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Reverb Engine
+  JUCE 8.0.11
+
+  One fully prepared copy of the wet network (pre-delay, early reflections,
+  parallel combs or an FDN plus a decimated low-band comb set, series
+  all-passes - or, for a near-free preview, pre-delay into velvet noise
+  alone). All delay memory is allocated in prepare(), so an engine can be
+  built on a background thread and handed to the audio thread ready to
+  run.
+
+  Each reverb program (ReverbPrograms.h) gets its own processChunk
+  instantiation; process() looks up the current one once per block, and
+  a program change only re-lengths the delays inside the same memory.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SharcFilters.h"
+#include "LowBandNetwork.h"
+#include "FdnNetwork.h"
+#include "VelvetNoiseNetwork.h"
+#include "EarlyReflections.h"
+#include "ReverbPrograms.h"
+#include "MixedPrecision.h"
+#include "OfflineRenderPool.h"
+
+//==============================================================================
+// Everything that decides how much memory an engine owns
+//==============================================================================
+struct ReverbEngineSpec
+{
+    double sampleRate = 48000.0;
+    int maxBlockSize = 512;
+
+    bool operator==(const ReverbEngineSpec& other) const noexcept
+    {
+        return sampleRate == other.sampleRate && maxBlockSize == other.maxBlockSize;
+    }
+
+    bool operator!=(const ReverbEngineSpec& other) const noexcept { return !(*this == other); }
+};
+
+//==============================================================================
+// Late-reverb stage between the pre-delay and the all-passes
+//==============================================================================
+enum class ReverbAlgorithm
+{
+    sharc, // 4 parallel feedback combs, as on the DDX3216
+    fdn4,  // 4-line FDN, Householder feedback
+    fdn8,  // 8-line FDN, Hadamard feedback
+    velvet // sparse velvet-noise loops, no low band or all-passes
+};
+
+constexpr int numReverbAlgorithms = 4;
+
+//==============================================================================
+// Read-position modulation of the combs and long all-passes
+//==============================================================================
+enum class DelayModulation
+{
+    off,
+    linear,  // cheapest, slight HF loss while the delay moves
+    lagrange // 3rd-order Lagrange
+};
+
+constexpr int numDelayModulations = 3;
+
+//==============================================================================
+// Reverb Engine - pre-delay -> early reflections -> 4 parallel combs or FDN (+ low band) -> series all-passes
+//==============================================================================
+class DdxReverbEngine
+{
+public:
+    static constexpr int numCombs = ReverbPrograms::numCombs;
+    static constexpr int numAllpasses = ReverbPrograms::numAllpasses;
+
+    // The Cathedral program's tables, which the lane-packed network also uses
+    static constexpr auto& combDelays = ReverbPrograms::Cathedral::combDelays;
+    static constexpr auto& allpassDelays = ReverbPrograms::Cathedral::allpassDelays;
+
+    // CPU-guard quality tiers: 0 = full network, each step drops stages.
+    // All-passes are listed longest-first, so the shortest ones go first.
+    static constexpr int numQualityTiers = 4;
+    static constexpr int tierCombs[numQualityTiers] = { 4, 4, 2, 2 };
+    static constexpr int tierAllpasses[numQualityTiers] = { 8, 5, 5, 4 };
+    static constexpr double tierFadeSeconds = 0.05;
+
+    // All-passes each algorithm runs at most: the FDN is dense on its own,
+    // so it only keeps the longest ones, and velvet noise needs none
+    static constexpr int algorithmAllpasses[numReverbAlgorithms] = { 8, 4, 4, 0 };
+
+    // Modulation moves every other comb (the ones the CPU guard keeps) and
+    // the two longest all-passes; the short ones give the tail its grain and
+    // would only add chorus. Excursions are at 100% depth, either side of
+    // the fixed delay.
+    static constexpr int numModulatedCombs = 2;
+    static constexpr int numModulatedAllpasses = 2;
+    static constexpr float maxCombExcursionMs = 0.5f;
+    static constexpr float maxAllpassExcursionMs = 0.2f;
+    static_assert(numModulatedCombs + numModulatedAllpasses <= DelayModulator::maxStages, "one LFO per modulated stage");
+
+    // Bass Multiply -10..+10 scales the low-band decay by 0.5x..2x
+    static constexpr float bassMultPerDoubling = 10.0f;
+
+    DdxReverbEngine() = default;
+
+    // Allocates and clears all delay memory - keep this off the audio thread
+    void prepare(const ReverbEngineSpec& newSpec)
+    {
+        spec = newSpec;
+        capacitySampleRate = spec.sampleRate;
+        const double sampleRate = spec.sampleRate;
+
+        combScratch.resize(static_cast<size_t>(spec.maxBlockSize));
+        modulationDelays.resize(static_cast<size_t>(spec.maxBlockSize));
+        wideScratch.resize(static_cast<size_t>(spec.maxBlockSize));
+        wideCombScratch.resize(static_cast<size_t>(spec.maxBlockSize));
+        earlyScratch.resize(static_cast<size_t>(spec.maxBlockSize));
+        gateScratch.resize(static_cast<size_t>(spec.maxBlockSize));
+
+        // Pre-delay buffer (max 500ms), with room behind it for the early
+        // reflection taps and for a whole block written ahead of the reads
+        int maxPreDelay = static_cast<int>(sampleRate * 0.5);
+        preDelayBuffer.resize(static_cast<size_t>(maxPreDelay + EarlyReflections::getMaxDelaySamples(sampleRate) + spec.maxBlockSize));
+        std::fill(preDelayBuffer.begin(), preDelayBuffer.end(), 0.0f);
+        preDelayWritePos = 0;
+
+        // Prepare comb filters
+        int maxCombDelay = static_cast<int>(sampleRate * 0.1); // 100ms max
+        for (auto& comb : combs)
+            comb.prepare(sampleRate, maxCombDelay, 0.7f, 5000.0f);
+
+        // Prepare all-pass filters
+        int maxAPDelay = static_cast<int>(sampleRate * 0.05); // 50ms max
+        for (auto& ap : allpasses)
+            ap.prepare(sampleRate, maxAPDelay, 0.5f);
+
+        lowBand.prepare(sampleRate, spec.maxBlockSize);
+        fdn.prepare(sampleRate);
+        velvet.prepare(sampleRate);
+        early.setSampleRate(sampleRate);
+        modulator.prepare(sampleRate, spec.maxBlockSize);
+
+        updateDelayLengths();
+        resetStageMixes();
+    }
+
+    // True if the spec fits in the memory this engine already owns
+    bool canReconfigure(const ReverbEngineSpec& newSpec) const noexcept
+    {
+        return newSpec.sampleRate <= capacitySampleRate
+            && newSpec.maxBlockSize <= static_cast<int>(combScratch.size());
+    }
+
+    // Switches to a new rate inside the existing buffers - no allocation,
+    // and the tail keeps ringing. Only valid when canReconfigure() is true.
+    void reconfigure(const ReverbEngineSpec& newSpec) noexcept
+    {
+        jassert(canReconfigure(newSpec));
+        spec = newSpec;
+
+        for (auto& comb : combs)
+            comb.setSampleRate(spec.sampleRate);
+
+        lowBand.setSampleRate(spec.sampleRate);
+        fdn.setSampleRate(spec.sampleRate);
+        velvet.setSampleRate(spec.sampleRate);
+        early.setSampleRate(spec.sampleRate);
+        modulator.setSampleRate(spec.sampleRate);
+
+        updateDelayLengths();
+        resetStageMixes();
+    }
+
+    const ReverbEngineSpec& getSpec() const noexcept { return spec; }
+
+    // Stamped by whoever builds the engine, so the audio thread can tell a
+    // current build from one a later request has superseded
+    void setGeneration(juce::uint32 newGeneration) noexcept { generation = newGeneration; }
+    juce::uint32 getGeneration() const noexcept { return generation; }
+
+    void reset()
+    {
+        std::fill(preDelayBuffer.begin(), preDelayBuffer.end(), 0.0f);
+        preDelayWritePos = 0;
+
+        for (auto& comb : combs)
+            comb.reset();
+
+        for (auto& ap : allpasses)
+            ap.reset();
+
+        lowBand.reset();
+        fdn.reset();
+        velvet.reset();
+        modulator.reset();
+
+        gateHoldRemaining = 0;
+        gateGain = 0.0f;
+    }
+
+    // Stages that are switched off or back on are crossfaded over tierFadeSeconds
+    void setQualityTier(int newTier) noexcept
+    {
+        newTier = juce::jlimit(0, numQualityTiers - 1, newTier);
+
+        if (newTier == qualityTier)
+            return;
+
+        qualityTier = newTier;
+
+        for (int c = 1; c < numCombs; ++c)
+            setStageActive(combMix[c], isCombActive(c, tierCombs[newTier]), [this, c] { combs[c].reset(); });
+
+        updateAllpassTargets();
+
+        // Keep the level roughly constant with fewer combs summed
+        combOutputGain.setTargetValue(0.25f * std::sqrt(static_cast<float>(numCombs) / static_cast<float>(tierCombs[newTier])));
+    }
+
+    int getQualityTier() const noexcept { return qualityTier; }
+
+    // Switches the late stage. The incoming stage starts from silence, so
+    // callers wanting a seamless change crossfade from another engine.
+    void setAlgorithm(ReverbAlgorithm newAlgorithm) noexcept
+    {
+        if (newAlgorithm == algorithm)
+            return;
+
+        // The low band sits out velvet mode, so it comes back clean
+        if (algorithm == ReverbAlgorithm::velvet)
+            lowBand.reset();
+
+        algorithm = newAlgorithm;
+
+        switch (algorithm)
+        {
+            case ReverbAlgorithm::sharc:
+                for (auto& comb : combs)
+                    comb.reset();
+                break;
+
+            case ReverbAlgorithm::fdn4:
+            case ReverbAlgorithm::fdn8:
+                fdn.setNumLines(algorithm == ReverbAlgorithm::fdn8 ? 8 : 4);
+                break;
+
+            case ReverbAlgorithm::velvet:
+                velvet.reset();
+                break;
+        }
+
+        updateAllpassTargets();
+        parkSkippedAllpasses();
+    }
+
+    ReverbAlgorithm getAlgorithm() const noexcept { return algorithm; }
+
+    // Switches delay tables and stage mix inside the existing memory. The
+    // combs and all-passes restart from silence, so callers wanting a
+    // seamless change crossfade from another engine.
+    void setProgram(ReverbProgram newProgram) noexcept
+    {
+        if (newProgram == program)
+            return;
+
+        program = newProgram;
+        programInfo = &getProgramInfo(program);
+
+        for (auto& comb : combs)
+            comb.reset();
+
+        for (auto& ap : allpasses)
+            ap.reset();
+
+        updateDelayLengths();
+        updateAllpassTargets();
+        parkSkippedAllpasses();
+    }
+
+    ReverbProgram getProgram() const noexcept { return program; }
+
+    // Pattern the program uses unless one is picked by hand
+    static EarlyPattern getProgramEarlyPattern(ReverbProgram program) noexcept
+    {
+        return getProgramInfo(program).early;
+    }
+
+    // The program's comb/all-pass network (48kHz delays), for the lane-packed network
+    struct ProgramTables
+    {
+        const int* combDelays;
+        const int* allpassDelays;
+        int maxAllpasses;
+        float decayScale;
+    };
+
+    static ProgramTables getProgramTables(ReverbProgram program) noexcept
+    {
+        const auto& info = getProgramInfo(program);
+        return { info.combDelays, info.allpassDelays, info.maxAllpasses, info.decayScale };
+    }
+
+    // The taps read history the pre-delay line already holds, so a new
+    // pattern needs no reset; callers crossfade for a seamless change
+    void setEarlyPattern(EarlyPattern newPattern) noexcept { early.setPattern(newPattern); }
+    EarlyPattern getEarlyPattern() const noexcept { return early.getPattern(); }
+
+    // Carries the comb sum and all-pass chain in double, for the 64-bit host
+    // path. Delay memory stays float and the SIMD kernels are bypassed, so it
+    // costs CPU; it changes rounding only, never the tail's shape.
+    void setWideAccumulation(bool shouldBeWide) noexcept { wideAccumulation = shouldBeWide; }
+    bool getWideAccumulation() const noexcept { return wideAccumulation; }
+
+    // Slow LFOs on the comb and long all-pass read positions. Turning it on
+    // or off restarts those stages (their memory changes layout), so callers
+    // wanting a seamless change crossfade; depth and rate follow at once.
+    // The CPU guard drops Lagrange to linear from tier 1 on.
+    void setModulation(DelayModulation newModulation, float depthPct, float rateHz) noexcept
+    {
+        if (newModulation != modulation)
+        {
+            modulation = newModulation;
+            const bool modulated = modulation != DelayModulation::off;
+
+            for (int c = 0; c < numCombs; ++c)
+                combs[c].setModulated(modulated && c % (numCombs / numModulatedCombs) == 0);
+
+            for (int a = 0; a < numModulatedAllpasses; ++a)
+                allpasses[a].setModulated(modulated);
+
+            modulator.reset();
+        }
+
+        modulationDepth = juce::jlimit(0.0f, 1.0f, depthPct / 100.0f);
+        modulator.setRate(rateHz);
+    }
+
+    DelayModulation getModulation() const noexcept { return modulation; }
+
+    // Largest magnitude still held in the network's delay memory
+    float getStatePeak() const noexcept
+    {
+        float peak = 0.0f;
+
+        if (!preDelayBuffer.empty())
+        {
+            auto range = juce::FloatVectorOperations::findMinAndMax(preDelayBuffer.data(), static_cast<int>(preDelayBuffer.size()));
+            peak = juce::jmax(-range.getStart(), range.getEnd());
+        }
+
+        for (auto& comb : combs)
+            peak = juce::jmax(peak, comb.getStatePeak());
+
+        for (auto& ap : allpasses)
+            peak = juce::jmax(peak, ap.getStatePeak());
+
+        peak = juce::jmax(peak, fdn.getStatePeak(), velvet.getStatePeak());
+
+        return juce::jmax(peak, lowBand.getStatePeak());
+    }
+
+    // Maps the DDX3216 front-panel values onto this engine's coefficients
+    void setParameters(float decayTime, float predelayMs, float dampingPct,
+                       float diffusion, float bassMult) noexcept
+    {
+        const auto sampleRate = static_cast<float>(spec.sampleRate);
+
+        preDelaySamples = static_cast<int>(predelayMs * sampleRate / 1000.0f);
+        preDelaySamples = juce::jlimit(0, static_cast<int>(sampleRate * 0.5f), preDelaySamples);
+
+        // Each program covers its own slice of the Decay range
+        decayTime *= programInfo->decayScale;
+
+        const float dampingFreq = getDampingFreq(dampingPct);
+        const float combGain = getCombGain(decayTime, sampleRate, programInfo->combDelays);
+
+        for (auto& comb : combs)
+        {
+            comb.setDampingFreq(dampingFreq);
+            comb.setGain(combGain);
+        }
+
+        fdn.setParameters(decayTime, dampingFreq);
+        velvet.setParameters(decayTime, dampingFreq);
+
+        // Bass multiply gives the low band its own decay time
+        lowBand.setParameters(decayTime * std::exp2(bassMult / bassMultPerDoubling), dampingFreq);
+
+        const float apGain = getAllpassGain(diffusion);
+
+        for (auto& ap : allpasses)
+            ap.setGain(apGain);
+    }
+
+    // Front-panel mappings, shared with the lane-packed network
+
+    // Damping: 0% = bright (20kHz), 100% = dark (2kHz)
+    static float getDampingFreq(float dampingPct) noexcept
+    {
+        return juce::jmap(dampingPct, 0.0f, 100.0f, 20000.0f, 2000.0f);
+    }
+
+    // Decay time affects feedback gain: RT60 = -60dB decay time
+    // g = 10^(-3 * T / RT60) where T is delay time in seconds
+    static float getCombGain(float decayTime, float sampleRate, const int* delays = combDelays) noexcept
+    {
+        float avgDelayMs = (delays[0] + delays[1] + delays[2] + delays[3]) / 4.0f
+            * 1000.0f / sampleRate;
+        float combGain = std::pow(10.0f, -3.0f * avgDelayMs / (decayTime * 1000.0f));
+        return juce::jlimit(0.1f, 0.99f, combGain);
+    }
+
+    // Diffusion: 0 = minimal, 20 = maximum
+    static float getAllpassGain(float diffusion) noexcept
+    {
+        return juce::jmap(diffusion, 0.0f, 20.0f, 0.3f, 0.7f);
+    }
+
+    // Runs the wet network in place on a mono block of any length
+    // With a task pool the low band runs alongside the main combs
+    void process(float* monoData, int numSamples, bool useSIMD, RenderTaskPool* pool = nullptr) noexcept
+    {
+        const auto chunkProcessor = programInfo->chunkProcessor;
+
+        for (int offset = 0; offset < numSamples; offset += spec.maxBlockSize)
+            (this->*chunkProcessor)(monoData + offset, juce::jmin(spec.maxBlockSize, numSamples - offset), useSIMD, pool);
+    }
+
+private:
+    //==============================================================================
+    // Program registry
+    //==============================================================================
+    using ChunkProcessor = void (DdxReverbEngine::*)(float*, int, bool, RenderTaskPool*) noexcept;
+
+    // What the engine needs from a program outside its inner loops, plus
+    // the chunk processor specialised for it
+    struct ProgramInfo
+    {
+        const int* combDelays;
+        const int* allpassDelays;
+        int maxAllpasses;
+        float decayScale;
+        EarlyPattern early;
+        ChunkProcessor chunkProcessor;
+    };
+
+    template <typename Program>
+    static constexpr ProgramInfo makeProgramInfo() noexcept
+    {
+        return { Program::combDelays, Program::allpassDelays, Program::maxAllpasses, Program::decayScale,
+                 Program::early, &DdxReverbEngine::processChunk<Program> };
+    }
+
+    // In ReverbProgram order
+    static const ProgramInfo& getProgramInfo(ReverbProgram program) noexcept
+    {
+        static constexpr ProgramInfo programs[numReverbPrograms] =
+        {
+            makeProgramInfo<ReverbPrograms::Cathedral>(),
+            makeProgramInfo<ReverbPrograms::Hall>(),
+            makeProgramInfo<ReverbPrograms::Room>(),
+            makeProgramInfo<ReverbPrograms::Plate>(),
+            makeProgramInfo<ReverbPrograms::Ambience>(),
+            makeProgramInfo<ReverbPrograms::Gated>()
+        };
+
+        return programs[static_cast<int>(program)];
+    }
+
+    // Scale the program's 48kHz delay tables to the current sample rate
+    void updateDelayLengths() noexcept
+    {
+        for (int i = 0; i < numCombs; ++i)
+            combs[i].setDelaySamples(static_cast<int>(programInfo->combDelays[i] * spec.sampleRate / 48000.0));
+
+        for (int i = 0; i < numAllpasses; ++i)
+            allpasses[i].setDelaySamples(static_cast<int>(programInfo->allpassDelays[i] * spec.sampleRate / 48000.0));
+
+        if (preDelayWritePos >= static_cast<int>(preDelayBuffer.size()))
+            preDelayWritePos = 0;
+    }
+
+    template <typename Program>
+    void processChunk(float* monoData, int numSamples, bool useSIMD, RenderTaskPool* pool) noexcept
+    {
+        // Gated programs key off the dry input, before it is overwritten
+        if constexpr (Program::gateMs > 0.0f)
+            updateGate<Program>(monoData, numSamples);
+
+        // Pre-delay - the whole block goes in first, so the pre-delay and every
+        // early-reflection tap can then be read back as contiguous spans
+        const int blockStart = preDelayWritePos;
+        writePreDelay(monoData, numSamples);
+
+        if (preDelaySamples > 0)
+            readPreDelay(blockStart - preDelaySamples, monoData, numSamples);
+
+        // Early reflections feed the late stage and are heard directly
+        const float* earlyOut = nullptr;
+
+        if (early.isActive())
+        {
+            earlyOut = earlyScratch.data();
+            early.process(preDelayBuffer.data(), static_cast<int>(preDelayBuffer.size()), blockStart, preDelaySamples,
+                          earlyScratch.data(), numSamples);
+
+            if constexpr (Program::earlyFeed == 1.0f)
+                juce::FloatVectorOperations::add(monoData, earlyOut, numSamples);
+            else if constexpr (Program::earlyFeed > 0.0f)
+                juce::FloatVectorOperations::addWithMultiply(monoData, earlyOut, Program::earlyFeed, numSamples);
+        }
+
+        // Velvet noise replaces everything after the pre-delay
+        if (algorithm == ReverbAlgorithm::velvet)
+        {
+            velvet.process(monoData, monoData, numSamples);
+            mixOutput<Program>(monoData, earlyOut, numSamples);
+            return;
+        }
+
+        // Split off the low band; the main combs only see what is above it
+        lowBand.split(monoData, numSamples);
+
+        if (wideAccumulation)
+            processLateAndDiffusers<Program>(monoData, wideScratch.data(), numSamples, useSIMD, pool);
+        else
+            processLateAndDiffusers<Program>(monoData, monoData, numSamples, useSIMD, pool);
+
+        mixOutput<Program>(monoData, earlyOut, numSamples);
+    }
+
+    // Late stage, low band and series all-passes. The signal runs through
+    // them in 'data': monoData itself, or a double copy that is narrowed back
+    // into monoData at the end. The low band and FDN are float either way.
+    template <typename Program, typename SampleType>
+    void processLateAndDiffusers(float* monoData, SampleType* data, int numSamples, bool useSIMD, RenderTaskPool* pool) noexcept
+    {
+        constexpr bool wide = std::is_same_v<SampleType, double>;
+
+        if (modulation != DelayModulation::off)
+            modulator.advance(numSamples);
+
+        // With a pool, the low band reverberates on another thread while the main
+        // late stage runs here; the two only meet in the sum below
+        const float* lowBandOut = nullptr;
+
+        if (pool != nullptr && numSamples >= RenderTaskPool::minParallelSamples)
+        {
+            pool->forEach(2, [&](int task)
+            {
+                if (task == 0)
+                    processLateStage(monoData, data, numSamples, useSIMD);
+                else
+                    lowBandOut = lowBand.processSplit(numSamples, useSIMD);
+            });
+        }
+        else
+        {
+            lowBandOut = lowBand.processSplit(numSamples, useSIMD);
+            processLateStage(monoData, data, numSamples, useSIMD);
+        }
+
+        // Recombine the bands ahead of the diffusers
+        MixedPrecision::add(data, lowBandOut, numSamples);
+
+        // Process series all-passes for diffusion
+        auto* stageIn = getCombScratch<SampleType>();
+
+        for (int a = 0; a < Program::maxAllpasses; ++a)
+        {
+            auto& ap = allpasses[a];
+            auto& mix = allpassMix[a];
+
+            if (isStageOff(mix))
+                continue;
+
+            // While fading in or out, blend against the stage's input
+            const bool blending = mix.isSmoothing();
+            if (blending)
+                MixedPrecision::copy(stageIn, data, numSamples);
+
+            if (ap.isModulated())
+                processModulated(ap, numModulatedCombs + a, maxAllpassExcursionMs, data, data, numSamples);
+            else if constexpr (wide)
+                ap.processBlockScalar(data, data, numSamples);
+            else if (useSIMD)
+                ap.processBlockSIMD(data, data, numSamples);
+            else
+                ap.processBlockScalar(data, data, numSamples);
+
+            if (blending)
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] = stageIn[i] + mix.getNextValue() * (data[i] - stageIn[i]);
+        }
+
+        if constexpr (wide)
+            MixedPrecision::copy(monoData, data, numSamples);
+    }
+
+    // Late stage and early reflections at the program's levels, then the gate
+    template <typename Program>
+    void mixOutput(float* monoData, const float* earlyOut, int numSamples) noexcept
+    {
+        if constexpr (Program::lateLevel != 1.0f)
+            juce::FloatVectorOperations::multiply(monoData, Program::lateLevel, numSamples);
+
+        if (earlyOut != nullptr)
+        {
+            if constexpr (Program::earlyLevel == 1.0f)
+                juce::FloatVectorOperations::add(monoData, earlyOut, numSamples);
+            else if constexpr (Program::earlyLevel > 0.0f)
+                juce::FloatVectorOperations::addWithMultiply(monoData, earlyOut, Program::earlyLevel, numSamples);
+        }
+
+        if constexpr (Program::gateMs > 0.0f)
+            juce::FloatVectorOperations::multiply(monoData, gateScratch.data(), numSamples);
+    }
+
+    // Per-sample wet gain for gated programs: open while the input has been
+    // above the threshold within the last gateMs. The hold includes the
+    // pre-delay, so the gate times the reverb rather than the input.
+    template <typename Program>
+    void updateGate(const float* input, int numSamples) noexcept
+    {
+        const auto sampleRate = static_cast<float>(spec.sampleRate);
+        const int holdSamples = preDelaySamples + static_cast<int>(Program::gateMs * sampleRate / 1000.0f);
+        const float attack = std::exp(-1.0f / (gateAttackSeconds * sampleRate));
+        const float release = std::exp(-1.0f / (ReverbPrograms::gateReleaseSeconds * sampleRate));
+        auto* gain = gateScratch.data();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (std::abs(input[i]) > ReverbPrograms::gateThreshold)
+                gateHoldRemaining = holdSamples;
+            else if (gateHoldRemaining > 0)
+                --gateHoldRemaining;
+
+            // Fast open so a retrigger into a ringing tail doesn't click
+            gateGain = gateHoldRemaining > 0 ? 1.0f + attack * (gateGain - 1.0f)
+                                             : release * gateGain;
+            gain[i] = gateGain;
+        }
+    }
+
+    void writePreDelay(const float* source, int numSamples) noexcept
+    {
+        const int size = static_cast<int>(preDelayBuffer.size());
+        const int first = juce::jmin(numSamples, size - preDelayWritePos);
+
+        juce::FloatVectorOperations::copy(preDelayBuffer.data() + preDelayWritePos, source, first);
+
+        if (first < numSamples)
+            juce::FloatVectorOperations::copy(preDelayBuffer.data(), source + first, numSamples - first);
+
+        preDelayWritePos = (preDelayWritePos + numSamples) % size;
+    }
+
+    void readPreDelay(int start, float* dest, int numSamples) const noexcept
+    {
+        const int size = static_cast<int>(preDelayBuffer.size());
+
+        if (start < 0)
+            start += size;
+
+        const int first = juce::jmin(numSamples, size - start);
+
+        juce::FloatVectorOperations::copy(dest, preDelayBuffer.data() + start, first);
+
+        if (first < numSamples)
+            juce::FloatVectorOperations::copy(dest + first, preDelayBuffer.data(), numSamples - first);
+    }
+
+    // Parallel combs (or the FDN) on the high band, accumulated in 'data' -
+    // monoData itself, or its double copy with wide accumulation
+    template <typename SampleType>
+    void processLateStage(float* monoData, SampleType* data, int numSamples, bool useSIMD) noexcept
+    {
+        constexpr bool wide = std::is_same_v<SampleType, double>;
+        auto* combOut = getCombScratch<SampleType>();
+
+        if (algorithm != ReverbAlgorithm::sharc)
+        {
+            // The FDN scales its own output
+            fdn.process(monoData, monoData, numSamples);
+
+            if constexpr (wide)
+                MixedPrecision::copy(data, monoData, numSamples);
+        }
+        else
+        {
+            if constexpr (wide)
+                MixedPrecision::copy(data, monoData, numSamples);
+
+            for (int c = 0; c < numCombs; ++c)
+            {
+                auto& mix = combMix[c];
+
+                // Switched off by the CPU guard
+                if (isStageOff(mix))
+                    continue;
+
+                if (combs[c].isModulated())
+                    processModulated(combs[c], c / (numCombs / numModulatedCombs), maxCombExcursionMs, data, combOut, numSamples);
+                else if constexpr (wide)
+                    combs[c].processBlockScalar(data, combOut, numSamples);
+                else if (useSIMD)
+                    combs[c].processBlockSIMD(data, combOut, numSamples);
+                else
+                    combs[c].processBlockScalar(data, combOut, numSamples);
+
+                // Mix combs equally (parallel topology)
+                if (c == 0)
+                {
+                    MixedPrecision::copy(data, combOut, numSamples);
+                }
+                else
+                {
+                    if (mix.isSmoothing() || mix.getTargetValue() != 1.0f)
+                        MixedPrecision::applyGain(mix, combOut, numSamples);
+
+                    MixedPrecision::add(data, combOut, numSamples);
+                }
+            }
+
+            // Scale down after parallel sum
+            MixedPrecision::applyGain(combOutputGain, data, numSamples);
+        }
+    }
+
+    // One comb or all-pass with its read point on LFO 'stage'. The excursion
+    // is kept inside the stage's memory and clear of its span limit.
+    template <typename Filter, typename SampleType>
+    void processModulated(Filter& filter, int stage, float maxExcursionMs,
+                          const SampleType* input, SampleType* output, int numSamples) noexcept
+    {
+        const auto baseDelay = static_cast<float>(filter.getDelaySamples());
+        const float excursion = juce::jmin(modulationDepth * maxExcursionMs * static_cast<float>(spec.sampleRate) / 1000.0f,
+                                           baseDelay - static_cast<float>(FractionalDelay::reach + 2),
+                                           static_cast<float>(filter.getMaxDelaySamples() - 3) - baseDelay);
+        auto* delays = modulationDelays.data();
+
+        modulator.getDelays(stage, baseDelay, juce::jmax(0.0f, excursion), delays, numSamples);
+
+        if (modulation == DelayModulation::lagrange && qualityTier == 0)
+            filter.template processBlockModulated<DelayInterpolation::lagrange3>(input, output, delays, numSamples);
+        else
+            filter.template processBlockModulated<DelayInterpolation::linear>(input, output, delays, numSamples);
+    }
+
+    template <typename SampleType>
+    SampleType* getCombScratch() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return wideCombScratch.data();
+        else
+            return combScratch.data();
+    }
+
+    int getActiveAllpasses() const noexcept
+    {
+        return juce::jmin(tierAllpasses[qualityTier], algorithmAllpasses[static_cast<int>(algorithm)],
+                          programInfo->maxAllpasses);
+    }
+
+    // Stages the chunk loop doesn't visit (velvet mode returns before the
+    // all-passes; a program can stop short of them) would never finish a
+    // fade - park them fully off instead
+    void parkSkippedAllpasses() noexcept
+    {
+        const int numVisited = algorithm == ReverbAlgorithm::velvet ? 0 : programInfo->maxAllpasses;
+
+        for (int a = numVisited; a < numAllpasses; ++a)
+            allpassMix[a].setCurrentAndTargetValue(0.0f);
+    }
+
+    void updateAllpassTargets() noexcept
+    {
+        const int numActive = getActiveAllpasses();
+
+        for (int a = 0; a < numAllpasses; ++a)
+            setStageActive(allpassMix[a], a < numActive, [this, a] { allpasses[a].reset(); });
+    }
+
+    static bool isCombActive(int index, int numActive) noexcept
+    {
+        // Keep every other comb so the remaining delays stay spread out
+        return numActive >= numCombs || index % (numCombs / numActive) == 0;
+    }
+
+    static bool isStageOff(const juce::SmoothedValue<float>& mix) noexcept
+    {
+        return !mix.isSmoothing() && mix.getTargetValue() == 0.0f;
+    }
+
+    // A stage coming back from fully off starts from clean delay memory
+    template <typename ResetFn>
+    static void setStageActive(juce::SmoothedValue<float>& mix, bool active, ResetFn&& resetStage) noexcept
+    {
+        if (active && isStageOff(mix))
+            resetStage();
+
+        mix.setTargetValue(active ? 1.0f : 0.0f);
+    }
+
+    void resetStageMixes() noexcept
+    {
+        for (int c = 0; c < numCombs; ++c)
+        {
+            combMix[c].reset(spec.sampleRate, tierFadeSeconds);
+            combMix[c].setCurrentAndTargetValue(isCombActive(c, tierCombs[qualityTier]) ? 1.0f : 0.0f);
+        }
+
+        for (int a = 0; a < numAllpasses; ++a)
+        {
+            allpassMix[a].reset(spec.sampleRate, tierFadeSeconds);
+            allpassMix[a].setCurrentAndTargetValue(a < getActiveAllpasses() ? 1.0f : 0.0f);
+        }
+
+        combOutputGain.reset(spec.sampleRate, tierFadeSeconds);
+        combOutputGain.setCurrentAndTargetValue(0.25f * std::sqrt(static_cast<float>(numCombs) / static_cast<float>(tierCombs[qualityTier])));
+    }
+
+    ReverbEngineSpec spec;
+    juce::uint32 generation = 0;
+    double capacitySampleRate = 0.0; // rate the delay memory was sized for
+
+    std::array<SharcCombFilter, numCombs> combs;
+    std::array<SharcAllpassFilter, numAllpasses> allpasses;
+    LowBandNetwork lowBand;
+    FdnNetwork fdn;
+    VelvetNoiseNetwork velvet;
+    EarlyReflections early;
+    DelayModulator modulator;
+    ReverbAlgorithm algorithm = ReverbAlgorithm::sharc;
+    ReverbProgram program = ReverbProgram::cathedral;
+    const ProgramInfo* programInfo = &getProgramInfo(ReverbProgram::cathedral);
+
+    // Pre-delay line
+    std::vector<float> preDelayBuffer;
+    int preDelayWritePos = 0;
+    int preDelaySamples = 0;
+
+    // Comb, early-reflection and gate scratch, sized to the block so nothing
+    // is allocated per block
+    std::vector<float> combScratch;
+    std::vector<float> earlyScratch;
+    std::vector<float> gateScratch;
+
+    // Delay modulation - per-sample read delays, reused stage by stage
+    DelayModulation modulation = DelayModulation::off;
+    float modulationDepth = 0.5f;
+    std::vector<float> modulationDelays;
+
+    // Double working copies for wide accumulation
+    bool wideAccumulation = false;
+    std::vector<double> wideScratch;
+    std::vector<double> wideCombScratch;
+
+    // Gated programs
+    static constexpr float gateAttackSeconds = 0.001f;
+    int gateHoldRemaining = 0;
+    float gateGain = 0.0f;
+
+    // Per-stage gains used to crossfade CPU-guard tier changes
+    int qualityTier = 0;
+    std::array<juce::SmoothedValue<float>, numCombs> combMix;
+    std::array<juce::SmoothedValue<float>, numAllpasses> allpassMix;
+    juce::SmoothedValue<float> combOutputGain { 0.25f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DdxReverbEngine)
+};
@@ -0,0 +1,130 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Reverb Programs
+  JUCE 8.0.11
+
+  The DDX3216's reverb programs as compile-time descriptions: delay tables
+  for the combs and all-passes, the early-reflection pattern, and how the
+  early and late stages are mixed. DdxReverbEngine builds one processChunk
+  per program from these, so everything a program fixes is a constant in
+  its inner loops; the engine picks the function once per block.
+
+  Every table must fit the delay memory DdxReverbEngine::prepare()
+  allocates (combs 100ms, all-passes 50ms), so switching programs only
+  changes lengths inside the same buffers.
+*/
+
+#pragma once
+#include "EarlyReflections.h"
+
+//==============================================================================
+// Programs - appended only, the "program" parameter stores the index
+//==============================================================================
+enum class ReverbProgram
+{
+    cathedral,
+    hall,
+    room,
+    plate,
+    ambience,
+    gated
+};
+
+constexpr int numReverbPrograms = 6;
+
+namespace ReverbPrograms
+{
+    constexpr int numCombs = 4;
+    constexpr int numAllpasses = 8;
+
+    // Delays are at 48kHz. decayScale maps the Decay control onto the
+    // program's range; earlyFeed is how much of the early reflections the
+    // late stage hears, earlyLevel and lateLevel set the output mix.
+    // A program with gateMs > 0 cuts the wet output that long after the
+    // input drops below the gate threshold.
+
+    // Prime-number delays (classic Schroeder approach) - the original program
+    struct Cathedral
+    {
+        static constexpr int combDelays[numCombs] = { 1116, 1188, 1277, 1356 };
+        static constexpr int allpassDelays[numAllpasses] = { 556, 441, 313, 391, 347, 113, 37, 59 };
+        static constexpr int maxAllpasses = 8;
+        static constexpr float decayScale = 1.0f;
+        static constexpr EarlyPattern early = EarlyPattern::cathedral;
+        static constexpr float earlyFeed = 1.0f;
+        static constexpr float earlyLevel = 1.0f;
+        static constexpr float lateLevel = 1.0f;
+        static constexpr float gateMs = 0.0f;
+    };
+
+    struct Hall
+    {
+        static constexpr int combDelays[numCombs] = { 1031, 1103, 1187, 1259 };
+        static constexpr int allpassDelays[numAllpasses] = { 479, 373, 283, 337, 307, 101, 31, 53 };
+        static constexpr int maxAllpasses = 8;
+        static constexpr float decayScale = 0.8f;
+        static constexpr EarlyPattern early = EarlyPattern::hall;
+        static constexpr float earlyFeed = 0.8f;
+        static constexpr float earlyLevel = 0.8f;
+        static constexpr float lateLevel = 1.0f;
+        static constexpr float gateMs = 0.0f;
+    };
+
+    struct Room
+    {
+        static constexpr int combDelays[numCombs] = { 617, 683, 739, 797 };
+        static constexpr int allpassDelays[numAllpasses] = { 269, 211, 163, 191, 173, 71, 29, 43 };
+        static constexpr int maxAllpasses = 6;
+        static constexpr float decayScale = 0.25f;
+        static constexpr EarlyPattern early = EarlyPattern::room;
+        static constexpr float earlyFeed = 0.7f;
+        static constexpr float earlyLevel = 1.0f;
+        static constexpr float lateLevel = 0.8f;
+        static constexpr float gateMs = 0.0f;
+    };
+
+    // No early reflections: dense from the first sample, all diffusers in
+    struct Plate
+    {
+        static constexpr int combDelays[numCombs] = { 787, 853, 929, 991 };
+        static constexpr int allpassDelays[numAllpasses] = { 613, 487, 379, 431, 397, 149, 67, 89 };
+        static constexpr int maxAllpasses = 8;
+        static constexpr float decayScale = 0.6f;
+        static constexpr EarlyPattern early = EarlyPattern::off;
+        static constexpr float earlyFeed = 0.0f;
+        static constexpr float earlyLevel = 0.0f;
+        static constexpr float lateLevel = 1.0f;
+        static constexpr float gateMs = 0.0f;
+    };
+
+    // Mostly early reflections over a short, quiet tail
+    struct Ambience
+    {
+        static constexpr int combDelays[numCombs] = { 431, 479, 521, 563 };
+        static constexpr int allpassDelays[numAllpasses] = { 199, 157, 113, 131, 97, 47, 23, 31 };
+        static constexpr int maxAllpasses = 4;
+        static constexpr float decayScale = 0.1f;
+        static constexpr EarlyPattern early = EarlyPattern::room;
+        static constexpr float earlyFeed = 0.5f;
+        static constexpr float earlyLevel = 1.0f;
+        static constexpr float lateLevel = 0.5f;
+        static constexpr float gateMs = 0.0f;
+    };
+
+    // A long, dense hall cut short by a gate
+    struct Gated
+    {
+        static constexpr int combDelays[numCombs] = { 1031, 1103, 1187, 1259 };
+        static constexpr int allpassDelays[numAllpasses] = { 556, 441, 313, 391, 347, 113, 37, 59 };
+        static constexpr int maxAllpasses = 8;
+        static constexpr float decayScale = 1.0f;
+        static constexpr EarlyPattern early = EarlyPattern::hall;
+        static constexpr float earlyFeed = 1.0f;
+        static constexpr float earlyLevel = 0.7f;
+        static constexpr float lateLevel = 1.0f;
+        static constexpr float gateMs = 250.0f;
+    };
+
+    // Gate opens at -40dBFS input and closes over gateReleaseSeconds
+    constexpr float gateThreshold = 0.01f;
+    constexpr float gateReleaseSeconds = 0.01f;
+}
@@ -0,0 +1,472 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - SHARC Filter Primitives
+  JUCE 8.0.11
+
+  Feedback comb and all-pass sections modelled on the SHARC ADSP-21160 code.
+  Each filter offers a scalar (authentic) and SIMD (optimized) block routine.
+  The scalar routines take float or double samples: with double the
+  arithmetic runs in double and only the delay memory stays float.
+
+  A modulated filter uses its whole delay memory as one ring and reads it
+  at a fractional delay per sample (see ModulatedDelay.h) instead of
+  looping over the delay length.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ModulatedDelay.h"
+
+//==============================================================================
+// SHARC-style Feedback Comb Filter (Classic Schroeder Topology)
+// This is the CORRECT implementation used in vintage digital reverbs
+//==============================================================================
+class SharcCombFilter
+{
+public:
+    SharcCombFilter() = default;
+
+    void prepare(double sRate, int maxDelaySamples, float initialGain = 0.7f, float dampingFreq = 5000.0f)
+    {
+        delayLine.resize(maxDelaySamples);
+        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+        writeIndex = 0;
+        this->delaySamples = juce::jlimit(1, maxDelaySamples, maxDelaySamples);
+        this->feedbackGain = initialGain;
+        this->sRate = sRate;
+
+        // Damping filter (one-pole lowpass in feedback path)
+        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * dampingFreq / (float)sRate);
+        filterState = 0.0f;
+        prepared = true;
+    }
+
+    void setDelaySamples(int newDelay)
+    {
+        delaySamples = juce::jlimit(1, (int)delayLine.size(), newDelay);
+
+        // Keep the write head inside the (possibly shorter) loop
+        if (!modulated && writeIndex >= delaySamples)
+            writeIndex = 0;
+    }
+
+    int getDelaySamples() const noexcept { return delaySamples; }
+    int getMaxDelaySamples() const noexcept { return static_cast<int>(delayLine.size()); }
+
+    // The loop and ring layouts don't share memory, so switching starts clean
+    void setModulated(bool shouldBeModulated)
+    {
+        if (shouldBeModulated == modulated)
+            return;
+
+        modulated = shouldBeModulated;
+        reset();
+    }
+
+    bool isModulated() const noexcept { return modulated; }
+
+    void setGain(float newGain)
+    {
+        feedbackGain = juce::jlimit(0.0f, 0.99f, newGain);
+    }
+
+    // Re-targets the filter at a new rate without touching the delay memory
+    void setSampleRate(double newRate)
+    {
+        sRate = newRate;
+    }
+
+    void setDampingFreq(float freq)
+    {
+        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * freq / (float)sRate);
+    }
+
+    void reset()
+    {
+        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+        writeIndex = 0;
+        filterState = 0.0f;
+    }
+
+    // Largest magnitude held anywhere in the filter (vectorised scan)
+    float getStatePeak() const noexcept
+    {
+        if (delayLine.empty())
+            return 0.0f;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(delayLine.data(), (int)delayLine.size());
+        return juce::jmax(-range.getStart(), range.getEnd(), std::abs(filterState));
+    }
+
+    // Scalar version - CORRECT feedback comb topology
+    // Read old delayed sample FIRST, then write new sample
+    template <typename SampleType>
+    void processBlockScalar(const SampleType* input, SampleType* output, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        auto* buffer = delayLine.data();
+        int idx = writeIndex;
+        const int len = delaySamples;
+        const SampleType g = feedbackGain;
+        const SampleType damp = dampingCoeff;
+        SampleType flt = filterState;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // 1. READ old delayed sample
+            SampleType delayed = buffer[idx];
+
+            // 2. Apply one-pole lowpass damping to feedback
+            flt = delayed + damp * (flt - delayed);
+
+            // 3. FEEDBACK comb: new sample = input + g * dampedFeedback
+            SampleType newSample = input[i] + g * flt;
+
+            // 4. WRITE new sample to buffer
+            buffer[idx] = static_cast<float>(newSample);
+
+            // 5. OUTPUT is the delayed sample (or mix with input)
+            output[i] = newSample;
+
+            // 6. Advance circular buffer
+            if (++idx >= len) idx = 0;
+        }
+
+        writeIndex = idx;
+        filterState = static_cast<float>(flt);
+    }
+
+    // Modulated version - same topology, reading delays[i] samples back.
+    // Each span's reads are interpolated together, then the damping and
+    // feedback run per sample as in the scalar version.
+    template <DelayInterpolation interpolation, typename SampleType>
+    void processBlockModulated(const SampleType* input, SampleType* output, const float* delays, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        jassert(modulated);
+
+        auto* buffer = delayLine.data();
+        const int size = static_cast<int>(delayLine.size());
+        int idx = writeIndex;
+        const SampleType g = feedbackGain;
+        const SampleType damp = dampingCoeff;
+        SampleType flt = filterState;
+
+        alignas(32) float delayed[FractionalDelay::maxSpan];
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int spanLength = FractionalDelay::getSpanLength(delays + start, numSamples - start);
+            FractionalDelay::read<interpolation>(buffer, size, idx, delays + start, delayed, spanLength);
+
+            for (int i = 0; i < spanLength; ++i)
+            {
+                const SampleType delayedSample = delayed[i];
+                flt = delayedSample + damp * (flt - delayedSample);
+
+                const SampleType newSample = input[start + i] + g * flt;
+                buffer[idx] = static_cast<float>(newSample);
+                output[start + i] = newSample;
+
+                if (++idx >= size) idx = 0;
+            }
+
+            start += spanLength;
+        }
+
+        writeIndex = idx;
+        filterState = static_cast<float>(flt);
+    }
+
+    // SIMD version - same algorithm, vectorized
+    void processBlockSIMD(const float* input, float* output, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        using SIMD = juce::dsp::SIMDRegister<float>;
+        constexpr size_t simdWidth = SIMD::SIMDRegister::size();
+
+        auto* buffer = delayLine.data();
+        int idx = writeIndex;
+        const int len = delaySamples;
+        const float g = feedbackGain;
+        const float damp = dampingCoeff;
+        float flt = filterState;
+
+        size_t vectorSamples = (static_cast<size_t>(numSamples) / simdWidth) * simdWidth;
+
+        // SIMD main loop
+        for (size_t i = 0; i < vectorSamples; i += simdWidth)
+        {
+            alignas(32) float delayed[8] = { 0 }; // Max SIMD width
+            for (size_t j = 0; j < simdWidth; ++j)
+                delayed[j] = buffer[(idx + static_cast<int>(j)) % len];
+
+            SIMD delayedVec = SIMD::fromRawArray(delayed);
+            SIMD inputVec = SIMD::fromRawArray(input + i);
+
+            // Apply damping (simplified - per-sample would be more accurate)
+            alignas(32) float dampedVals[8] = { 0 };
+            for (size_t j = 0; j < simdWidth; ++j)
+            {
+                flt = delayed[j] + damp * (flt - delayed[j]);
+                dampedVals[j] = flt;
+            }
+
+            SIMD dampedVec = SIMD::fromRawArray(dampedVals);
+            SIMD gVec(g);
+            SIMD outVec = inputVec + gVec * dampedVec; // Fixed: proper SIMD multiplication
+
+            outVec.copyToRawArray(output + i);
+
+            // Store back to buffer
+            alignas(32) float toStore[8] = { 0 };
+            outVec.copyToRawArray(toStore);
+            for (size_t j = 0; j < simdWidth; ++j)
+                buffer[(idx + static_cast<int>(j)) % len] = toStore[j];
+
+            idx = (idx + static_cast<int>(simdWidth)) % len;
+        }
+
+        // Scalar tail
+        for (int i = static_cast<int>(vectorSamples); i < numSamples; ++i)
+        {
+            float delayed = buffer[idx];
+            flt = delayed + damp * (flt - delayed);
+            float newSample = input[i] + g * flt;
+            buffer[idx] = newSample;
+            output[i] = newSample;
+            if (++idx >= len) idx = 0;
+        }
+
+        writeIndex = idx;
+        filterState = flt;
+    }
+
+private:
+    std::vector<float> delayLine;
+    int delaySamples = 1000;
+    int writeIndex = 0;
+    float feedbackGain = 0.7f;
+    float dampingCoeff = 0.5f;
+    float filterState = 0.0f;
+    double sRate = 48000.0;
+    bool prepared = false;
+    bool modulated = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharcCombFilter)
+};
+
+//==============================================================================
+// SHARC-style All-Pass Filter (Classic Schroeder topology)
+// Formula: y[n] = -g*x[n] + x[n-M] + g*y[n-M]
+//==============================================================================
+class SharcAllpassFilter
+{
+public:
+    SharcAllpassFilter() = default;
+
+    void prepare(double /*sampleRate*/, int maxDelaySamples, float initialGain = 0.5f)
+    {
+        delayLine.resize(maxDelaySamples);
+        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+        writeIndex = 0;
+        this->delaySamples = juce::jlimit(1, maxDelaySamples, maxDelaySamples);
+        this->apGain = initialGain;
+        prepared = true;
+    }
+
+    void setDelaySamples(int newDelay)
+    {
+        delaySamples = juce::jlimit(1, (int)delayLine.size(), newDelay);
+
+        // Keep the write head inside the (possibly shorter) loop
+        if (!modulated && writeIndex >= delaySamples)
+            writeIndex = 0;
+    }
+
+    int getDelaySamples() const noexcept { return delaySamples; }
+    int getMaxDelaySamples() const noexcept { return static_cast<int>(delayLine.size()); }
+
+    // The loop and ring layouts don't share memory, so switching starts clean
+    void setModulated(bool shouldBeModulated)
+    {
+        if (shouldBeModulated == modulated)
+            return;
+
+        modulated = shouldBeModulated;
+        reset();
+    }
+
+    bool isModulated() const noexcept { return modulated; }
+
+    void setGain(float newGain)
+    {
+        apGain = juce::jlimit(-0.99f, 0.99f, newGain);
+    }
+
+    void reset()
+    {
+        std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+        writeIndex = 0;
+    }
+
+    // Largest magnitude held anywhere in the filter (vectorised scan)
+    float getStatePeak() const noexcept
+    {
+        if (delayLine.empty())
+            return 0.0f;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(delayLine.data(), (int)delayLine.size());
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+
+    // Scalar version - exact SHARC all-pass
+    // CRITICAL: Read delayed sample FIRST, then write new value
+    template <typename SampleType>
+    void processBlockScalar(const SampleType* input, SampleType* output, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        auto* buffer = delayLine.data();
+        int idx = writeIndex;
+        const int len = delaySamples;
+        const SampleType g = apGain;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // 1. READ old delayed sample
+            SampleType delayed = buffer[idx];
+
+            // 2. Calculate output: y[n] = -g*x[n] + x[n-M] + g*y[n-M]
+            //    Simplified: out = -g*input + delayed (since delayed already contains x[n-M] + g*y[n-M-M])
+            SampleType out = -g * input[i] + delayed;
+
+            // 3. WRITE new value: x[n] + g*y[n-M]
+            buffer[idx] = static_cast<float>(input[i] + delayed * g);
+
+            // 4. Output result
+            output[i] = out;
+
+            // 5. Advance circular buffer
+            if (++idx >= len) idx = 0;
+        }
+
+        writeIndex = idx;
+    }
+
+    // Modulated version - same topology, reading delays[i] samples back.
+    // With a span's reads interpolated up front, nothing inside the span
+    // feeds back, so what is left is a plain multiply-add per sample.
+    template <DelayInterpolation interpolation, typename SampleType>
+    void processBlockModulated(const SampleType* input, SampleType* output, const float* delays, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        jassert(modulated);
+
+        auto* buffer = delayLine.data();
+        const int size = static_cast<int>(delayLine.size());
+        int idx = writeIndex;
+        const SampleType g = apGain;
+
+        alignas(32) float delayed[FractionalDelay::maxSpan];
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int spanLength = FractionalDelay::getSpanLength(delays + start, numSamples - start);
+            FractionalDelay::read<interpolation>(buffer, size, idx, delays + start, delayed, spanLength);
+
+            // Contiguous runs of the ring, so the loop has no wrap test
+            for (int done = 0; done < spanLength;)
+            {
+                const int run = juce::jmin(spanLength - done, size - idx);
+                const SampleType* in = input + start + done;
+                SampleType* out = output + start + done;
+                float* ring = buffer + idx;
+                const float* d = delayed + done;
+
+                for (int i = 0; i < run; ++i)
+                {
+                    const SampleType x = in[i];
+                    const SampleType delayedSample = d[i];
+
+                    ring[i] = static_cast<float>(x + delayedSample * g);
+                    out[i] = -g * x + delayedSample;
+                }
+
+                done += run;
+                idx += run;
+
+                if (idx >= size) idx = 0;
+            }
+
+            start += spanLength;
+        }
+
+        writeIndex = idx;
+    }
+
+    // SIMD version
+    void processBlockSIMD(const float* input, float* output, int numSamples) noexcept
+    {
+        if (!prepared) return;
+
+        using SIMD = juce::dsp::SIMDRegister<float>;
+        constexpr size_t simdWidth = SIMD::SIMDRegister::size();
+
+        auto* buffer = delayLine.data();
+        int idx = writeIndex;
+        const int len = delaySamples;
+        const float g = apGain;
+
+        size_t vectorSamples = (static_cast<size_t>(numSamples) / simdWidth) * simdWidth;
+
+        // SIMD main loop
+        for (size_t i = 0; i < vectorSamples; i += simdWidth)
+        {
+            alignas(32) float delayed[8] = { 0 };
+            for (size_t j = 0; j < simdWidth; ++j)
+                delayed[j] = buffer[(idx + static_cast<int>(j)) % len];
+
+            SIMD delayedVec = SIMD::fromRawArray(delayed);
+            SIMD inputVec = SIMD::fromRawArray(input + i);
+            SIMD gVec(g);
+
+            SIMD outVec = gVec * inputVec * (-1.0f) + delayedVec; // Fixed: proper SIMD ops
+            outVec.copyToRawArray(output + i);
+
+            // Store new values
+            SIMD newVals = inputVec + gVec * delayedVec; // Fixed: proper SIMD multiplication
+            alignas(32) float toStore[8] = { 0 };
+            newVals.copyToRawArray(toStore);
+            for (size_t j = 0; j < simdWidth; ++j)
+                buffer[(idx + static_cast<int>(j)) % len] = toStore[j];
+
+            idx = (idx + static_cast<int>(simdWidth)) % len;
+        }
+
+        // Scalar tail
+        for (int i = static_cast<int>(vectorSamples); i < numSamples; ++i)
+        {
+            float delayed = buffer[idx];
+            float out = -g * input[i] + delayed;
+            buffer[idx] = input[i] + delayed * g;
+            output[i] = out;
+            if (++idx >= len) idx = 0;
+        }
+
+        writeIndex = idx;
+    }
+
+private:
+    std::vector<float> delayLine;
+    int delaySamples = 500;
+    int writeIndex = 0;
+    float apGain = 0.5f;
+    bool prepared = false;
+    bool modulated = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharcAllpassFilter)
+};
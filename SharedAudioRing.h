@@ -0,0 +1,360 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Shared Audio Ring
+  JUCE 8.0.11
+
+  Block transport between the plugin and an out-of-process engine (Linux).
+  One POSIX shared-memory segment holds a small SPSC ring of block slots;
+  each slot carries the audio for one host block plus the parameter values
+  it should be processed with. The engine processes a slot in place, so
+  audio is never serialised or copied on the engine side.
+
+  head counts blocks submitted by the plugin, tail counts blocks finished
+  by the engine. Both are futex words: a side only makes the wake syscall
+  when the other has announced it is about to sleep, so a busy engine
+  costs two atomic stores per block and nothing else.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#if JUCE_LINUX
+ #include <fcntl.h>
+ #include <linux/futex.h>
+ #include <sys/mman.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+// Shared Audio Ring - one segment, plugin on one end, engine on the other
+//==============================================================================
+class SharedAudioRing
+{
+public:
+    static constexpr juce::uint32 magic = 0x52534444; // 'D' 'D' 'S' 'R'
+    static constexpr juce::uint32 version = 1;
+    static constexpr int numChannels = 2;
+    static constexpr int numSlots = 4;
+    static constexpr int maxParameters = 64;
+
+    enum EngineState : juce::uint32 { starting = 0, ready = 1, shutdown = 2 };
+
+    struct alignas(64) Header
+    {
+        juce::uint32 magic;
+        juce::uint32 version;
+        juce::int32 maxBlockSize;
+        juce::int32 numParameters;
+        juce::int32 clientProcessId;
+        double sampleRate;
+
+        alignas(64) std::atomic<juce::uint32> head;         // futex word
+        std::atomic<juce::uint32> engineWaiting;
+        alignas(64) std::atomic<juce::uint32> tail;         // futex word
+        std::atomic<juce::uint32> clientWaiting;
+        alignas(64) std::atomic<juce::uint32> engineState;  // futex word
+    };
+
+    struct alignas(64) Slot
+    {
+        juce::int32 numSamples;
+        float engineMicroseconds; // engine-side processing time, for overhead figures
+        float parameters[maxParameters];
+    };
+
+    static_assert(sizeof(std::atomic<juce::uint32>) == sizeof(juce::uint32)
+                  && std::atomic<juce::uint32>::is_always_lock_free, "futex words must be plain 32-bit");
+
+    SharedAudioRing() = default;
+    ~SharedAudioRing() { close(); }
+
+    static bool isSupported() noexcept { return JUCE_LINUX != 0; }
+
+    // Plugin side: creates (and later unlinks) a fresh segment
+    bool create(const juce::String& segmentName, double sampleRate, int maxBlockSize, int numParameters)
+    {
+        jassert(numParameters <= maxParameters);
+        close();
+
+       #if JUCE_LINUX
+        const int fd = ::shm_open(segmentName.toRawUTF8(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+        if (fd < 0)
+            return false;
+
+        const size_t size = getSegmentSize(maxBlockSize);
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0 || !map(fd, size))
+        {
+            ::close(fd);
+            ::shm_unlink(segmentName.toRawUTF8());
+            return false;
+        }
+
+        ::close(fd);
+        name = segmentName;
+        owner = true;
+
+        auto& h = getHeader();
+        h.magic = magic;
+        h.version = version;
+        h.maxBlockSize = maxBlockSize;
+        h.numParameters = numParameters;
+        h.clientProcessId = static_cast<juce::int32>(::getpid());
+        h.sampleRate = sampleRate;
+        h.head = 0;
+        h.engineWaiting = 0;
+        h.tail = 0;
+        h.clientWaiting = 0;
+        h.engineState = starting;
+        return true;
+       #else
+        juce::ignoreUnused(segmentName, sampleRate, maxBlockSize, numParameters);
+        return false;
+       #endif
+    }
+
+    // Engine side: maps a segment the plugin created
+    bool open(const juce::String& segmentName)
+    {
+        close();
+
+       #if JUCE_LINUX
+        const int fd = ::shm_open(segmentName.toRawUTF8(), O_RDWR, 0600);
+
+        if (fd < 0)
+            return false;
+
+        // Map the header first to learn the full size
+        Header probe;
+
+        if (::pread(fd, &probe, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header))
+            || probe.magic != magic || probe.version != version || !map(fd, getSegmentSize(probe.maxBlockSize)))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        ::close(fd);
+        name = segmentName;
+        owner = false;
+        return true;
+       #else
+        juce::ignoreUnused(segmentName);
+        return false;
+       #endif
+    }
+
+    void close() noexcept
+    {
+       #if JUCE_LINUX
+        if (memory != nullptr)
+            ::munmap(memory, memorySize);
+
+        if (owner)
+            ::shm_unlink(name.toRawUTF8());
+       #endif
+
+        memory = nullptr;
+        memorySize = 0;
+        owner = false;
+        name.clear();
+    }
+
+    bool isOpen() const noexcept { return memory != nullptr; }
+    const juce::String& getName() const noexcept { return name; }
+
+    Header& getHeader() const noexcept { return *static_cast<Header*>(memory); }
+
+    Slot& getSlot(juce::uint32 sequence) const noexcept
+    {
+        return *reinterpret_cast<Slot*>(static_cast<char*>(memory) + getSlotOffset(static_cast<int>(sequence % numSlots)));
+    }
+
+    // Channel data follows each slot header
+    float* getSlotChannel(juce::uint32 sequence, int channel) const noexcept
+    {
+        auto* audio = reinterpret_cast<float*>(reinterpret_cast<char*>(&getSlot(sequence)) + sizeof(Slot));
+        return audio + static_cast<size_t>(channel) * static_cast<size_t>(getHeader().maxBlockSize);
+    }
+
+    //==============================================================================
+    // Plugin side
+    //==============================================================================
+    // Hands slot 'head' to the engine
+    void submit() noexcept
+    {
+        auto& h = getHeader();
+        h.head.store(h.head.load(std::memory_order_relaxed) + 1);
+
+        if (h.engineWaiting.load() != 0)
+            futexWake(h.head);
+    }
+
+    // Spins briefly, then sleeps until the engine has caught up with head.
+    // False on timeout - the engine is late, hung or gone.
+    bool waitForEngine(double timeoutMicroseconds, double spinMicroseconds) noexcept
+    {
+        auto& h = getHeader();
+        const auto target = h.head.load(std::memory_order_relaxed);
+        const auto start = juce::Time::getHighResolutionTicks();
+        const auto ticksPerMicrosecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+
+        for (;;)
+        {
+            const auto done = h.tail.load(std::memory_order_acquire);
+
+            if (done == target)
+                return true;
+
+            const double elapsed = static_cast<double>(juce::Time::getHighResolutionTicks() - start) / ticksPerMicrosecond;
+
+            if (elapsed >= timeoutMicroseconds)
+                return false;
+
+            if (elapsed < spinMicroseconds)
+                continue;
+
+            h.clientWaiting.store(1);
+
+            if (h.tail.load() == done)
+                futexWait(h.tail, done, timeoutMicroseconds - elapsed);
+
+            h.clientWaiting.store(0);
+        }
+    }
+
+    // True once the engine has finished every block submitted so far
+    bool hasEngineCaughtUp() const noexcept
+    {
+        auto& h = getHeader();
+        return h.tail.load(std::memory_order_acquire) == h.head.load(std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    // Engine side
+    //==============================================================================
+    // Sleeps until there is a block past 'completed', the plugin asks for a
+    // shutdown or the timeout passes. Returns the current head.
+    juce::uint32 waitForWork(juce::uint32 completed, double timeoutMicroseconds) noexcept
+    {
+        auto& h = getHeader();
+        auto submitted = h.head.load(std::memory_order_acquire);
+
+        if (submitted != completed || h.engineState.load() == shutdown)
+            return submitted;
+
+        h.engineWaiting.store(1);
+
+        if (h.head.load() == completed)
+            futexWait(h.head, completed, timeoutMicroseconds);
+
+        h.engineWaiting.store(0);
+        return h.head.load(std::memory_order_acquire);
+    }
+
+    void complete() noexcept
+    {
+        auto& h = getHeader();
+        h.tail.store(h.tail.load(std::memory_order_relaxed) + 1);
+
+        if (h.clientWaiting.load() != 0)
+            futexWake(h.tail);
+    }
+
+    void setEngineState(EngineState state) noexcept
+    {
+        auto& h = getHeader();
+        h.engineState.store(state);
+        futexWake(h.engineState);
+        futexWake(h.head);
+    }
+
+    // Plugin side, message thread: waits for the engine to report ready
+    bool waitForEngineState(EngineState state, int timeoutMs) noexcept
+    {
+        auto& h = getHeader();
+        const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+
+        for (;;)
+        {
+            const auto current = h.engineState.load();
+
+            if (current == static_cast<juce::uint32>(state))
+                return true;
+
+            const auto now = juce::Time::getMillisecondCounter();
+
+            if (now >= deadline)
+                return false;
+
+            futexWait(h.engineState, current, (deadline - now) * 1000.0);
+        }
+    }
+
+private:
+    static size_t getSlotStride(int maxBlockSize) noexcept
+    {
+        const size_t bytes = sizeof(Slot) + static_cast<size_t>(numChannels * maxBlockSize) * sizeof(float);
+        return (bytes + 63) & ~static_cast<size_t>(63);
+    }
+
+    static size_t getSegmentSize(int maxBlockSize) noexcept
+    {
+        return sizeof(Header) + numSlots * getSlotStride(maxBlockSize);
+    }
+
+    size_t getSlotOffset(int index) const noexcept
+    {
+        return sizeof(Header) + static_cast<size_t>(index) * getSlotStride(getHeader().maxBlockSize);
+    }
+
+    bool map(int fd, size_t size) noexcept
+    {
+       #if JUCE_LINUX
+        void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (address == MAP_FAILED)
+            return false;
+
+        // Keep the ring resident: a page fault on the audio thread would cost
+        // more than the whole round trip
+        ::mlock(address, size);
+
+        memory = address;
+        memorySize = size;
+        return true;
+       #else
+        juce::ignoreUnused(fd, size);
+        return false;
+       #endif
+    }
+
+    // Shared between processes, so no FUTEX_PRIVATE_FLAG
+    static void futexWait(std::atomic<juce::uint32>& word, juce::uint32 expected, double timeoutMicroseconds) noexcept
+    {
+       #if JUCE_LINUX
+        const auto micros = static_cast<long long>(juce::jmax(0.0, timeoutMicroseconds));
+        timespec timeout { static_cast<time_t>(micros / 1000000), static_cast<long>((micros % 1000000) * 1000) };
+        ::syscall(SYS_futex, reinterpret_cast<juce::uint32*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+       #else
+        juce::ignoreUnused(word, expected, timeoutMicroseconds);
+       #endif
+    }
+
+    static void futexWake(std::atomic<juce::uint32>& word) noexcept
+    {
+       #if JUCE_LINUX
+        ::syscall(SYS_futex, reinterpret_cast<juce::uint32*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+       #else
+        juce::ignoreUnused(word);
+       #endif
+    }
+
+    void* memory = nullptr;
+    size_t memorySize = 0;
+    bool owner = false;
+    juce::String name;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAudioRing)
+};
@@ -0,0 +1,72 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Tail Energy Tracker
+  JUCE 8.0.11
+
+  Decides when the reverb network can be put to sleep. Peaks are taken
+  with JUCE's vectorised min/max scan; once input and wet output have been
+  below -120 dBFS for a short hold time, the caller confirms with a scan of
+  the network's delay memory before suspending. Any input wakes it again
+  in the same block.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Tail Energy Tracker
+//==============================================================================
+class TailEnergyTracker
+{
+public:
+    // -120 dBFS
+    static constexpr float silenceThreshold = 1.0e-6f;
+
+    // Vectorised absolute peak of a block
+    template <typename SampleType>
+    static float getPeak(const SampleType* data, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return 0.0f;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+        return static_cast<float>(juce::jmax(-range.getStart(), range.getEnd()));
+    }
+
+    static bool isSilent(float peak) noexcept { return peak < silenceThreshold; }
+
+    void prepare(double sampleRate, double holdSeconds = 0.05)
+    {
+        holdSamples = juce::jmax(1, static_cast<int>(sampleRate * holdSeconds));
+        wake();
+    }
+
+    // Call after a processed block; returns true once input and output have
+    // been silent long enough that the network state is worth checking
+    bool update(float inputPeak, float outputPeak, int numSamples) noexcept
+    {
+        if (isSilent(inputPeak) && isSilent(outputPeak))
+            silentSamples = juce::jmin(silentSamples + numSamples, holdSamples);
+        else
+            silentSamples = 0;
+
+        return silentSamples >= holdSamples;
+    }
+
+    void sleep() noexcept { asleep = true; }
+
+    // Network still holds energy - wait another hold time before rechecking
+    void rearm() noexcept { silentSamples = 0; }
+
+    void wake() noexcept
+    {
+        asleep = false;
+        silentSamples = 0;
+    }
+
+    bool isAsleep() const noexcept { return asleep; }
+
+private:
+    int holdSamples = 2400;
+    int silentSamples = 0;
+    bool asleep = false;
+};
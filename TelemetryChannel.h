@@ -0,0 +1,54 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Telemetry Channel
+  JUCE 8.0.11
+
+  Lock-free triple buffer from the audio thread to the editor. The writer
+  fills its private back slot and publishes it with one atomic exchange;
+  the reader swaps the freshest slot to the front the same way. Neither
+  side ever waits, and the reader only ever sees whole snapshots - never
+  half of one block's values and half of the next.
+
+  One writer thread and one reader thread. Snapshot must be trivially
+  copyable.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Telemetry Channel - single-producer / single-consumer triple buffer
+//==============================================================================
+template <typename Snapshot>
+class TelemetryChannel
+{
+public:
+    static_assert(std::is_trivially_copyable_v<Snapshot>, "snapshots are copied between threads");
+
+    // Writer: fill this in, then publish()
+    Snapshot& getWriteSlot() noexcept { return slots[static_cast<size_t>(backIndex)]; }
+
+    // Writer: the back slot becomes the middle one, flagged as fresh
+    void publish() noexcept
+    {
+        backIndex = middle.exchange(backIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader: the latest published snapshot (the previous one again if
+    // nothing new has arrived since the last call)
+    const Snapshot& read() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshFlag) != 0)
+            frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+
+        return slots[static_cast<size_t>(frontIndex)];
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<Snapshot, 3> slots {};
+    std::atomic<int> middle { 1 };
+    int backIndex = 0;  // writer only
+    int frontIndex = 2; // reader only
+};
@@ -0,0 +1,181 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Velvet-Noise Late Reverb
+  JUCE 8.0.11
+
+  Low-cost alternative to the comb/all-pass network for monitor mixes and
+  previews. Four damped recirculating loops each carry one segment of
+  velvet noise: a sparse set of +/-1 taps, one per grid cell at a random
+  offset. Each pass round a loop is one segment of the tail, scaled by
+  that loop's decay gain, so each sample costs a few additions plus one
+  feedback update per loop - no all-passes needed.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Velvet-Noise Network - 4 damped loops read through sparse +/-1 taps
+//==============================================================================
+class VelvetNoiseNetwork
+{
+public:
+    static constexpr int numLoops = 4;
+    static constexpr int tapsPerLoop = 6;
+
+    // Loop lengths at 48kHz (primes, ~30-40ms): about 700 taps per second overall
+    static constexpr int loopDelays[numLoops] = { 1447, 1621, 1811, 1973 };
+
+    // Allocates and clears all delay memory - keep this off the audio thread
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        for (auto& loop : loops)
+            loop.buffer.resize(static_cast<size_t>(sampleRate * 0.05)); // 50ms max
+
+        updateDelayLengths();
+        updateGains();
+        reset();
+    }
+
+    // Re-targets a lower rate inside the existing memory
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        updateDelayLengths();
+        updateGains();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& loop : loops)
+        {
+            std::fill(loop.buffer.begin(), loop.buffer.end(), 0.0f);
+            loop.writePos = 0;
+            loop.filterState = 0.0f;
+        }
+    }
+
+    float getStatePeak() const noexcept
+    {
+        float peak = 0.0f;
+
+        for (auto& loop : loops)
+        {
+            if (loop.buffer.empty())
+                continue;
+
+            auto range = juce::FloatVectorOperations::findMinAndMax(loop.buffer.data(), static_cast<int>(loop.buffer.size()));
+            peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+        }
+
+        return peak;
+    }
+
+    // Same RT60 and damping mapping as the combs, per loop length
+    void setParameters(float newDecayTime, float dampingFreq) noexcept
+    {
+        decayTime = newDecayTime;
+        dampingCoeff = std::exp(-juce::MathConstants<float>::twoPi * dampingFreq / static_cast<float>(sampleRate));
+        updateGains();
+    }
+
+    // Input and output may be the same buffer
+    void process(const float* input, float* output, int numSamples) noexcept
+    {
+        const float damp = dampingCoeff;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = input[i];
+            float out = 0.0f;
+
+            for (auto& loop : loops)
+            {
+                auto* buffer = loop.buffer.data();
+                const int len = loop.length;
+                const int pos = loop.writePos;
+
+                // Sparse taps: additions and subtractions only
+                float sum = 0.0f;
+
+                for (int k = 0; k < tapsPerLoop; ++k)
+                {
+                    int readPos = pos - loop.tapDelays[k];
+                    if (readPos < 0)
+                        readPos += len;
+
+                    sum += loop.tapSigns[k] ? buffer[readPos] : -buffer[readPos];
+                }
+
+                out += sum;
+
+                // Damped recirculation - the whole loop is one delay of len
+                const float delayed = buffer[pos];
+                loop.filterState = delayed + damp * (loop.filterState - delayed);
+                buffer[pos] = x + loop.gain * loop.filterState;
+
+                loop.writePos = pos + 1 >= len ? 0 : pos + 1;
+            }
+
+            output[i] = out * outputScale;
+        }
+    }
+
+private:
+    struct Loop
+    {
+        std::vector<float> buffer;
+        int length = 1;
+        int writePos = 0;
+        float gain = 0.0f;
+        float filterState = 0.0f;
+        int tapDelays[tapsPerLoop] = {};
+        bool tapSigns[tapsPerLoop] = {};
+    };
+
+    // Fixed seed, so every instance (and every session) has the same tail
+    void updateDelayLengths() noexcept
+    {
+        juce::Random random(0x44445833);
+
+        for (int l = 0; l < numLoops; ++l)
+        {
+            auto& loop = loops[static_cast<size_t>(l)];
+            loop.length = juce::jlimit(tapsPerLoop + 1, static_cast<int>(loop.buffer.size()),
+                                       static_cast<int>(loopDelays[l] * sampleRate / 48000.0));
+
+            if (loop.writePos >= loop.length)
+                loop.writePos = 0;
+
+            // One tap per grid cell at a random offset, random sign
+            const int cell = loop.length / tapsPerLoop;
+
+            for (int k = 0; k < tapsPerLoop; ++k)
+            {
+                loop.tapDelays[k] = 1 + k * cell + random.nextInt(juce::jmax(1, cell - 1));
+                loop.tapSigns[k] = random.nextBool();
+            }
+        }
+    }
+
+    void updateGains() noexcept
+    {
+        for (int l = 0; l < numLoops; ++l)
+        {
+            const float loopSeconds = static_cast<float>(loopDelays[l]) / 48000.0f;
+            loops[static_cast<size_t>(l)].gain = juce::jlimit(0.1f, 0.99f, std::pow(10.0f, -3.0f * loopSeconds / decayTime));
+        }
+    }
+
+    double sampleRate = 48000.0;
+    float decayTime = 5.0f;
+    float dampingCoeff = 0.0f;
+
+    // Uncorrelated taps add in power: same level as the 4-comb sum * 0.25
+    const float outputScale = 1.0f / (numLoops * std::sqrt(static_cast<float>(tapsPerLoop)));
+
+    std::array<Loop, numLoops> loops;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VelvetNoiseNetwork)
+};
@@ -0,0 +1,229 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Work-Stealing Pool
+  JUCE 8.0.11
+
+  Scheduler for batch rendering outside a host (the render daemon). Every
+  worker has its own deque: tasks a worker submits go on the back of its
+  own deque and it takes them back from there, so a stream's next chunk
+  usually runs on the core that still has its delay memory in cache. An
+  idle worker first takes from the shared queue that outside threads
+  submit to, then steals from the front of another worker's deque - the
+  oldest, coldest work.
+
+  Tasks are chunk-sized (milliseconds), so each deque is a plain mutex
+  and deque; the locks are taken a few hundred times a second at most.
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+//==============================================================================
+// Work-Stealing Pool - one deque per worker plus a shared injection queue
+//==============================================================================
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(int numWorkers)
+    {
+        for (int i = 0; i < juce::jmax(1, numWorkers); ++i)
+            workers.push_back(std::make_unique<Worker>(*this, i));
+
+        for (auto& worker : workers)
+            worker->startThread();
+    }
+
+    ~WorkStealingPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        wakeAll();
+
+        for (auto& worker : workers)
+            worker->stopThread(-1);
+    }
+
+    int getNumWorkers() const noexcept { return static_cast<int>(workers.size()); }
+
+    // Any thread. From a worker the task stays local; from outside it goes
+    // to the shared queue.
+    void submit(Task task)
+    {
+        if (auto* worker = getCurrentWorker())
+        {
+            const std::lock_guard<std::mutex> lock(worker->lock);
+            worker->tasks.push_back(std::move(task));
+        }
+        else
+        {
+            const std::lock_guard<std::mutex> lock(injectedLock);
+            injected.push_back(std::move(task));
+        }
+
+        ++numQueued;
+        wakeOne();
+    }
+
+    // Time workers spent running tasks, summed over all workers
+    double getBusySeconds() const noexcept
+    {
+        double total = 0.0;
+
+        for (auto& worker : workers)
+            total += worker->busySeconds.load();
+
+        return total;
+    }
+
+    int getNumSteals() const noexcept { return numSteals.load(); }
+
+private:
+    struct Worker : public juce::Thread
+    {
+        Worker(WorkStealingPool& p, int i)
+            : juce::Thread("DDX3216 Render " + juce::String(i + 1)), pool(p), index(i)
+        {
+        }
+
+        void run() override
+        {
+            currentWorker = this;
+            juce::Random random(index + 1);
+
+            while (!threadShouldExit())
+            {
+                Task task;
+
+                if (pool.takeTask(*this, random, task))
+                {
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    task();
+                    busySeconds = busySeconds.load()
+                                + juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+                }
+                else
+                {
+                    pool.sleepUntilWork(*this);
+                }
+            }
+
+            currentWorker = nullptr;
+        }
+
+        WorkStealingPool& pool;
+        const int index;
+        std::mutex lock;
+        std::deque<Task> tasks;
+        std::atomic<double> busySeconds { 0.0 };
+    };
+
+    Worker* getCurrentWorker() const noexcept
+    {
+        return currentWorker != nullptr && &currentWorker->pool == this ? currentWorker : nullptr;
+    }
+
+    // Own deque (newest first), then the shared queue, then steal the oldest
+    // task of a randomly chosen victim
+    bool takeTask(Worker& self, juce::Random& random, Task& task)
+    {
+        if (popBack(self, task) || popInjected(task))
+            return true;
+
+        const int numWorkers = getNumWorkers();
+        const int first = random.nextInt(numWorkers);
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            auto& victim = *workers[static_cast<size_t>((first + i) % numWorkers)];
+
+            if (&victim != &self && popFront(victim, task))
+            {
+                ++numSteals;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool popBack(Worker& worker, Task& task)
+    {
+        const std::lock_guard<std::mutex> lock(worker.lock);
+
+        if (worker.tasks.empty())
+            return false;
+
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+        --numQueued;
+        return true;
+    }
+
+    bool popFront(Worker& worker, Task& task)
+    {
+        const std::lock_guard<std::mutex> lock(worker.lock);
+
+        if (worker.tasks.empty())
+            return false;
+
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        --numQueued;
+        return true;
+    }
+
+    bool popInjected(Task& task)
+    {
+        const std::lock_guard<std::mutex> lock(injectedLock);
+
+        if (injected.empty())
+            return false;
+
+        task = std::move(injected.front());
+        injected.pop_front();
+        --numQueued;
+        return true;
+    }
+
+    void sleepUntilWork(Worker& worker)
+    {
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wakeUp.wait_for(lock, std::chrono::milliseconds(idleWaitMs),
+                        [&] { return numQueued.load() > 0 || worker.threadShouldExit(); });
+    }
+
+    void wakeOne()
+    {
+        const std::lock_guard<std::mutex> lock(sleepLock);
+        wakeUp.notify_one();
+    }
+
+    void wakeAll()
+    {
+        const std::lock_guard<std::mutex> lock(sleepLock);
+        wakeUp.notify_all();
+    }
+
+    static constexpr int idleWaitMs = 50;
+
+    static inline thread_local Worker* currentWorker = nullptr;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex injectedLock;
+    std::deque<Task> injected;
+
+    std::atomic<int> numQueued { 0 };
+    std::atomic<int> numSteals { 0 };
+
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkStealingPool)
+};
@@ -0,0 +1,300 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Minimal CLAP Host Harness (Linux)
+
+  Loads the built .clap, offers it a std::thread-backed host thread pool,
+  plays an impulse followed by silence and checks what a real host relies
+  on: the tail rings out, the plugin reports a tail length, the thread-pool
+  extension is used, the plugin asks to SLEEP once the tail has died away,
+  and the state survives a save/load round trip.
+
+    ClapHostHarness path/to/DDX3216Reverb.clap
+
+  The CMake build makes it next to the .clap and ctest runs it against
+  that; the exit code is non-zero if any check fails.
+*/
+
+#include <clap/clap.h>
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr uint32_t blockSize = 512;
+    constexpr int maxSeconds = 60;
+
+    const clap_plugin_t* plugin = nullptr;
+    const clap_plugin_thread_pool_t* pluginThreadPool = nullptr;
+    std::atomic<int> threadPoolRequests { 0 };
+    std::atomic<int> threadPoolTasks { 0 };
+
+    //==============================================================================
+    // Host side
+    //==============================================================================
+    // Runs task 0 on the calling (audio) thread and the rest on fresh threads;
+    // a real host would keep its workers around, this only has to be correct
+    bool hostRequestExec(const clap_host_t*, uint32_t numTasks)
+    {
+        if (pluginThreadPool == nullptr)
+            return false;
+
+        ++threadPoolRequests;
+        threadPoolTasks += static_cast<int>(numTasks);
+
+        std::vector<std::thread> workers;
+
+        for (uint32_t i = 1; i < numTasks; ++i)
+            workers.emplace_back([i] { pluginThreadPool->exec(plugin, i); });
+
+        pluginThreadPool->exec(plugin, 0);
+
+        for (auto& worker : workers)
+            worker.join();
+
+        return true;
+    }
+
+    const clap_host_thread_pool_t hostThreadPool { hostRequestExec };
+
+    const void* hostGetExtension(const clap_host_t*, const char* id)
+    {
+        return std::strcmp(id, CLAP_EXT_THREAD_POOL) == 0 ? &hostThreadPool : nullptr;
+    }
+
+    void hostRequestRestart(const clap_host_t*) {}
+    void hostRequestProcess(const clap_host_t*) {}
+    void hostRequestCallback(const clap_host_t*) {}
+
+    const clap_host_t host
+    {
+        CLAP_VERSION_INIT, nullptr,
+        "DDX3216 Harness", "DDX3216", "", "1.0.0",
+        hostGetExtension, hostRequestRestart, hostRequestProcess, hostRequestCallback
+    };
+
+    uint32_t noEventsSize(const clap_input_events_t*) { return 0; }
+    const clap_event_header_t* noEventsGet(const clap_input_events_t*, uint32_t) { return nullptr; }
+    bool dropEvent(const clap_output_events_t*, const clap_event_header_t*) { return true; }
+
+    const clap_input_events_t inputEvents { nullptr, noEventsSize, noEventsGet };
+    const clap_output_events_t outputEvents { nullptr, dropEvent };
+
+    // Growable in-memory stream for the state round trip
+    struct MemoryStream
+    {
+        std::vector<char> data;
+        size_t readPos = 0;
+    };
+
+    int64_t streamWrite(const clap_ostream_t* stream, const void* buffer, uint64_t size)
+    {
+        auto& memory = *static_cast<MemoryStream*>(stream->ctx);
+        auto* bytes = static_cast<const char*>(buffer);
+        memory.data.insert(memory.data.end(), bytes, bytes + size);
+        return static_cast<int64_t>(size);
+    }
+
+    int64_t streamRead(const clap_istream_t* stream, void* buffer, uint64_t size)
+    {
+        auto& memory = *static_cast<MemoryStream*>(stream->ctx);
+        const size_t count = std::min(static_cast<size_t>(size), memory.data.size() - memory.readPos);
+        std::memcpy(buffer, memory.data.data() + memory.readPos, count);
+        memory.readPos += count;
+        return static_cast<int64_t>(count);
+    }
+
+    int failures = 0;
+
+    void check(bool condition, const char* what)
+    {
+        std::printf("%s  %s\n", condition ? "ok  " : "FAIL", what);
+
+        if (!condition)
+            ++failures;
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <plugin.clap>\n", argv[0]);
+        return 2;
+    }
+
+    void* library = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+
+    if (library == nullptr)
+    {
+        std::fprintf(stderr, "dlopen failed: %s\n", dlerror());
+        return 2;
+    }
+
+    auto* entry = static_cast<const clap_plugin_entry_t*>(dlsym(library, "clap_entry"));
+
+    if (entry == nullptr || !entry->init(argv[1]))
+    {
+        std::fprintf(stderr, "no usable clap_entry\n");
+        return 2;
+    }
+
+    auto* factory = static_cast<const clap_plugin_factory_t*>(entry->get_factory(CLAP_PLUGIN_FACTORY_ID));
+    check(factory != nullptr && factory->get_plugin_count(factory) == 1, "factory exposes one plugin");
+
+    const auto* descriptor = factory->get_plugin_descriptor(factory, 0);
+    plugin = factory->create_plugin(factory, &host, descriptor->id);
+    check(plugin != nullptr && plugin->init(plugin), "plugin created");
+
+    pluginThreadPool = static_cast<const clap_plugin_thread_pool_t*>(plugin->get_extension(plugin, CLAP_EXT_THREAD_POOL));
+    auto* tail = static_cast<const clap_plugin_tail_t*>(plugin->get_extension(plugin, CLAP_EXT_TAIL));
+    auto* state = static_cast<const clap_plugin_state_t*>(plugin->get_extension(plugin, CLAP_EXT_STATE));
+    auto* params = static_cast<const clap_plugin_params_t*>(plugin->get_extension(plugin, CLAP_EXT_PARAMS));
+
+    check(pluginThreadPool != nullptr, "thread-pool extension");
+    check(tail != nullptr, "tail extension");
+    check(state != nullptr, "state extension");
+    check(params != nullptr && params->count(plugin) > 0, "params extension");
+
+    check(plugin->activate(plugin, sampleRate, 1, blockSize) && plugin->start_processing(plugin), "activated at 48kHz");
+
+    //==============================================================================
+    // Impulse, then silence until the plugin asks to sleep
+    std::vector<float> inL(blockSize), inR(blockSize), outL(blockSize), outR(blockSize);
+    float* inputs[] = { inL.data(), inR.data() };
+    float* outputs[] = { outL.data(), outR.data() };
+
+    clap_audio_buffer_t input {};
+    input.data32 = inputs;
+    input.channel_count = 2;
+
+    clap_audio_buffer_t output {};
+    output.data32 = outputs;
+    output.channel_count = 2;
+
+    clap_process_t process {};
+    process.steady_time = 0;
+    process.frames_count = blockSize;
+    process.audio_inputs = &input;
+    process.audio_outputs = &output;
+    process.audio_inputs_count = 1;
+    process.audio_outputs_count = 1;
+    process.in_events = &inputEvents;
+    process.out_events = &outputEvents;
+
+    const uint32_t reportedTail = tail != nullptr ? tail->get(plugin) : 0;
+    const int maxBlocks = static_cast<int>(maxSeconds * sampleRate / blockSize);
+
+    float peak = 0.0f;
+    int lastAudibleBlock = -1;
+    int sleepBlock = -1;
+
+    for (int block = 0; block < maxBlocks; ++block)
+    {
+        std::fill(inL.begin(), inL.end(), 0.0f);
+        std::fill(inR.begin(), inR.end(), 0.0f);
+
+        if (block == 0)
+            inL[0] = inR[0] = 1.0f;
+
+        // Silent channels are flagged constant, as a real host would
+        input.constant_mask = block == 0 ? 0 : 3;
+
+        const auto status = plugin->process(plugin, &process);
+        process.steady_time += blockSize;
+
+        if (status == CLAP_PROCESS_ERROR)
+        {
+            check(false, "process returned an error");
+            break;
+        }
+
+        float blockPeak = 0.0f;
+
+        for (uint32_t i = 0; i < blockSize; ++i)
+            blockPeak = std::max({ blockPeak, std::abs(outL[i]), std::abs(outR[i]) });
+
+        peak = std::max(peak, blockPeak);
+
+        if (blockPeak > 1.0e-5f)
+            lastAudibleBlock = block;
+
+        if (status == CLAP_PROCESS_SLEEP)
+        {
+            sleepBlock = block;
+            break;
+        }
+    }
+
+    const double secondsPerBlock = blockSize / sampleRate;
+
+    std::printf("reported tail   %.2f s\n", reportedTail / sampleRate);
+    std::printf("audible until   %.2f s (peak %.4f)\n", (lastAudibleBlock + 1) * secondsPerBlock, peak);
+    std::printf("slept after     %.2f s\n", sleepBlock >= 0 ? (sleepBlock + 1) * secondsPerBlock : -1.0);
+    std::printf("thread pool     %d requests, %d tasks\n", threadPoolRequests.load(), threadPoolTasks.load());
+
+    check(peak > 0.0f && lastAudibleBlock > 0, "impulse produced a tail");
+    check(reportedTail > 0, "tail length reported");
+    check(sleepBlock >= 0, "plugin returned CLAP_PROCESS_SLEEP");
+    check(threadPoolRequests > 0, "host thread pool used");
+
+    //==============================================================================
+    // State round trip: a changed parameter comes back after load
+    if (state != nullptr && params != nullptr)
+    {
+        clap_param_info_t info {};
+        params->get_info(plugin, 0, &info);
+
+        double original = 0.0;
+        params->get_value(plugin, info.id, &original);
+
+        MemoryStream memory;
+        clap_ostream_t out { &memory, streamWrite };
+        check(state->save(plugin, &out) && !memory.data.empty(), "state saved");
+
+        const double changed = original < 0.5 ? 0.75 : 0.25;
+        clap_event_param_value_t event {};
+        event.header = { sizeof(event), 0, CLAP_CORE_EVENT_SPACE_ID, CLAP_EVENT_PARAM_VALUE, 0 };
+        event.param_id = info.id;
+        event.note_id = -1;
+        event.port_index = -1;
+        event.channel = -1;
+        event.key = -1;
+        event.value = changed;
+
+        const clap_input_events_t oneEvent
+        {
+            &event,
+            [] (const clap_input_events_t*) -> uint32_t { return 1; },
+            [] (const clap_input_events_t* list, uint32_t) { return static_cast<const clap_event_header_t*>(list->ctx); }
+        };
+
+        params->flush(plugin, &oneEvent, &outputEvents);
+
+        double current = 0.0;
+        params->get_value(plugin, info.id, &current);
+        check(std::abs(current - original) > 0.1, "parameter changed via flush");
+
+        clap_istream_t in { &memory, streamRead };
+        check(state->load(plugin, &in), "state loaded");
+
+        params->get_value(plugin, info.id, &current);
+        check(std::abs(current - original) < 1.0e-4, "parameter restored by state load");
+    }
+
+    plugin->stop_processing(plugin);
+    plugin->deactivate(plugin);
+    plugin->destroy(plugin);
+    entry->deinit();
+    dlclose(library);
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
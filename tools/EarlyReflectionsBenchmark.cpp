@@ -0,0 +1,113 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Early Reflections Benchmark
+  JUCE 8.0.11
+
+  Console app built from the DSP headers plus this file. For every tap
+  pattern it times the early-reflection stage on its own and the whole
+  mono engine with that pattern, and prints the cost per sample:
+
+    EarlyReflectionsBenchmark [sampleRate] [blockSize]
+
+  The stage's cost grows with the tap count, not the delay: each tap is
+  one multiply-add pass over the block.
+*/
+
+#include <JuceHeader.h>
+#include "../ReverbEngine.h"
+
+namespace
+{
+    constexpr double secondsPerRun = 10.0;
+
+    template <typename ProcessFn>
+    double timeNanosecondsPerSample(int blockSize, double sampleRate, ProcessFn&& process)
+    {
+        const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+
+        // Warm up caches and let the tail build
+        for (int block = 0; block < numBlocks / 10; ++block)
+            process();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    void fillNoise(std::vector<float>& data, juce::Random& random)
+    {
+        for (auto& sample : data)
+            sample = random.nextFloat() * 0.5f - 0.25f;
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    const char* const patternNames[numEarlyPatterns] = { "off", "cathedral", "hall", "room" };
+    const double realtimeNanosecondsPerSample = 1.0e9 / sampleRate;
+
+    juce::Random random(1);
+    std::vector<float> noise(static_cast<size_t>(blockSize));
+    std::vector<float> input(static_cast<size_t>(blockSize));
+    std::vector<float> output(static_cast<size_t>(blockSize));
+
+    // A pre-delay-sized ring of noise, read exactly as the engine reads it
+    std::vector<float> ring(static_cast<size_t>(sampleRate * 0.5) + static_cast<size_t>(EarlyReflections::getMaxDelaySamples(sampleRate))
+                            + static_cast<size_t>(blockSize));
+    fillNoise(ring, random);
+    fillNoise(noise, random);
+
+    std::printf("%.0f Hz, %d-sample blocks\n", sampleRate, blockSize);
+    std::printf("pattern     taps   ER ns/smp   ns/tap/smp   engine ns/smp   ER share %%   engine %% realtime\n");
+
+    for (int p = 0; p < numEarlyPatterns; ++p)
+    {
+        const auto pattern = static_cast<EarlyPattern>(p);
+
+        EarlyReflections early;
+        early.setSampleRate(sampleRate);
+        early.setPattern(pattern);
+
+        const int predelay = static_cast<int>(sampleRate * 0.05);
+        int blockStart = 0;
+
+        const double earlyNs = timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            early.process(ring.data(), static_cast<int>(ring.size()), blockStart, predelay, output.data(), blockSize);
+            blockStart = (blockStart + blockSize) % static_cast<int>(ring.size());
+        });
+
+        DdxReverbEngine engine;
+        engine.prepare({ sampleRate, blockSize });
+        engine.setAlgorithm(ReverbAlgorithm::sharc);
+        engine.setEarlyPattern(pattern);
+        engine.setParameters(5.0f, 50.0f, 50.0f, 10.0f, 0.0f);
+
+        const double engineNs = timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            std::copy(noise.begin(), noise.end(), input.begin());
+            engine.process(input.data(), blockSize, true);
+        });
+
+        const int numTaps = early.getNumTaps();
+
+        std::printf("%-10s  %4d   %9.2f   %10.3f   %13.2f   %10.1f   %17.2f\n",
+                    patternNames[p], numTaps, earlyNs, numTaps > 0 ? earlyNs / numTaps : 0.0,
+                    engineNs, 100.0 * earlyNs / engineNs, 100.0 * engineNs / realtimeNanosecondsPerSample);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Lane Network Benchmark
+  JUCE 8.0.11
+
+  Console app built from the DSP headers plus this file. Times the
+  lane-packed network against the mono engine it stands in for, so the
+  "costs about the same as mono" claim for true stereo and the "a quarter
+  of four instances" claim for quad mode have numbers:
+
+    LaneBenchmark [sampleRate] [blockSize]
+
+  The "shared delays" row is true stereo without the right lane's offset:
+  every line is one frame load, so the difference to the real true stereo
+  row is what reading the offset lane costs. Quad mode runs four engines
+  with four different pre-delays, against four mono engines in a row.
+*/
+
+#include <JuceHeader.h>
+#include "../LaneReverbNetwork.h"
+
+namespace
+{
+    constexpr double secondsPerRun = 10.0;
+    constexpr int stereoSpread = 23; // what the plugin offsets the right lane by
+    constexpr int numQuadEngines = 4;
+
+    template <typename ProcessFn>
+    double timeNanosecondsPerSample(int blockSize, double sampleRate, ProcessFn&& process)
+    {
+        const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+
+        // Warm up caches and let the tail build
+        for (int block = 0; block < numBlocks / 10; ++block)
+            process();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    double timeMonoEngine(double sampleRate, int blockSize, const std::vector<float>& noise)
+    {
+        DdxReverbEngine engine;
+        engine.prepare({ sampleRate, blockSize });
+        engine.setAlgorithm(ReverbAlgorithm::sharc);
+        engine.setParameters(5.0f, 50.0f, 50.0f, 10.0f, 0.0f);
+
+        std::vector<float> input(noise.size());
+
+        return timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            std::copy(noise.begin(), noise.end(), input.begin());
+            engine.process(input.data(), blockSize, true);
+        });
+    }
+
+    // numLanes lanes of one network, lane n offset by spreads[n] and
+    // pre-delayed by predelays[n] ms
+    double timeLanes(int numLanes, const int* spreads, const float* predelays,
+                     double sampleRate, int blockSize, const std::vector<float>& noise)
+    {
+        auto network = std::make_unique<LaneReverbNetwork>();
+        network->prepare(sampleRate);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            network->setLaneSpread(lane, spreads[lane]);
+            network->setLaneParameters(lane, 5.0f, predelays[lane], 50.0f, 10.0f);
+        }
+
+        juce::AudioBuffer<float> lanes(numLanes, blockSize);
+
+        return timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+                lanes.copyFrom(lane, 0, noise.data(), blockSize);
+
+            network->process(lanes.getArrayOfWritePointers(), numLanes, blockSize);
+        });
+    }
+
+    void printRow(const char* name, double ns, double monoNs, int numEngines = 1)
+    {
+        std::printf("%-26s  %10.2f   %8.2fx   %13.2f\n", name, ns, ns / monoNs, ns / numEngines);
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    juce::Random random(1);
+    std::vector<float> noise(static_cast<size_t>(blockSize));
+
+    for (auto& sample : noise)
+        sample = random.nextFloat() * 0.5f - 0.25f;
+
+    const int sharedSpreads[LaneReverbNetwork::maxLanes] = {};
+    const int stereoSpreads[LaneReverbNetwork::maxLanes] = { 0, stereoSpread };
+    const float sharedPredelays[LaneReverbNetwork::maxLanes] = { 50.0f, 50.0f, 50.0f, 50.0f };
+    const float quadPredelays[LaneReverbNetwork::maxLanes] = { 20.0f, 35.0f, 50.0f, 80.0f };
+    static_assert(LaneReverbNetwork::maxLanes >= numQuadEngines, "quad mode fits one network");
+
+    const double monoNs = timeMonoEngine(sampleRate, blockSize, noise);
+
+    std::printf("%.0f Hz, %d-sample blocks, %d lanes per network\n", sampleRate, blockSize, LaneReverbNetwork::maxLanes);
+    std::printf("network                        ns/smp    vs mono   ns/smp/engine\n");
+    printRow("mono engine", monoNs, monoNs);
+    printRow("true stereo", timeLanes(2, stereoSpreads, sharedPredelays, sampleRate, blockSize, noise), monoNs);
+    printRow("true stereo, shared delays", timeLanes(2, sharedSpreads, sharedPredelays, sampleRate, blockSize, noise), monoNs);
+    printRow("four mono engines", monoNs * numQuadEngines, monoNs, numQuadEngines);
+    printRow("quad", timeLanes(numQuadEngines, sharedSpreads, quadPredelays, sampleRate, blockSize, noise), monoNs, numQuadEngines);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Delay Modulation Benchmark
+  JUCE 8.0.11
+
+  Console app built from the DSP headers plus this file. For every program
+  it times the mono engine with modulation off, linear and Lagrange, on the
+  scalar and SIMD kernels, and prints what modulation adds per sample:
+
+    ModulationBenchmark [sampleRate] [blockSize]
+
+  The increase has a budget per engine instance; the exit code is 1 if any
+  case goes over it, so the check can run in CI.
+*/
+
+#include <JuceHeader.h>
+#include "../ReverbEngine.h"
+
+namespace
+{
+    constexpr double secondsPerRun = 10.0;
+
+    // Most an instance may slow down with modulation on, in percent. Depth
+    // doesn't change the cost; 100% is timed so the spans are shortest.
+    constexpr double budgetPercent = 50.0;
+
+    template <typename ProcessFn>
+    double timeNanosecondsPerSample(int blockSize, double sampleRate, ProcessFn&& process)
+    {
+        const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+
+        // Warm up caches and let the tail build
+        for (int block = 0; block < numBlocks / 10; ++block)
+            process();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    double timeEngine(ReverbProgram program, DelayModulation modulation, bool useSIMD,
+                      double sampleRate, int blockSize, const std::vector<float>& noise)
+    {
+        DdxReverbEngine engine;
+        engine.prepare({ sampleRate, blockSize });
+        engine.setAlgorithm(ReverbAlgorithm::sharc);
+        engine.setProgram(program);
+        engine.setModulation(modulation, 100.0f, 0.5f);
+        engine.setParameters(5.0f, 50.0f, 50.0f, 10.0f, 0.0f);
+
+        std::vector<float> input(noise.size());
+
+        return timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            std::copy(noise.begin(), noise.end(), input.begin());
+            engine.process(input.data(), blockSize, useSIMD);
+        });
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    const char* const programNames[numReverbPrograms] = { "cathedral", "hall", "room", "plate", "ambience", "gated" };
+
+    juce::Random random(1);
+    std::vector<float> noise(static_cast<size_t>(blockSize));
+
+    for (auto& sample : noise)
+        sample = random.nextFloat() * 0.5f - 0.25f;
+
+    std::printf("%.0f Hz, %d-sample blocks, 100%% depth, budget +%.0f%%\n", sampleRate, blockSize, budgetPercent);
+    std::printf("program     kernel   off ns/smp   linear ns/smp   linear +%%   lagrange ns/smp   lagrange +%%\n");
+
+    bool withinBudget = true;
+
+    for (int p = 0; p < numReverbPrograms; ++p)
+    {
+        for (const bool useSIMD : { false, true })
+        {
+            const auto program = static_cast<ReverbProgram>(p);
+            const double offNs = timeEngine(program, DelayModulation::off, useSIMD, sampleRate, blockSize, noise);
+            const double linearNs = timeEngine(program, DelayModulation::linear, useSIMD, sampleRate, blockSize, noise);
+            const double lagrangeNs = timeEngine(program, DelayModulation::lagrange, useSIMD, sampleRate, blockSize, noise);
+
+            const double linearIncrease = 100.0 * (linearNs - offNs) / offNs;
+            const double lagrangeIncrease = 100.0 * (lagrangeNs - offNs) / offNs;
+            const bool over = linearIncrease > budgetPercent || lagrangeIncrease > budgetPercent;
+            withinBudget = withinBudget && !over;
+
+            std::printf("%-10s  %-6s   %10.2f   %13.2f   %9.1f   %15.2f   %11.1f%s\n",
+                        programNames[p], useSIMD ? "simd" : "scalar", offNs, linearNs, linearIncrease,
+                        lagrangeNs, lagrangeIncrease, over ? "   OVER BUDGET" : "");
+        }
+    }
+
+    return withinBudget ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Offline Render Benchmark
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file. Bounces the same audio with the
+  render task pool off and with it spread over 2..4 cores, and prints the
+  speedup of each against the pool being off:
+
+    OfflineRenderBenchmark [input.wav] [blockSize]
+
+  Without a file it renders a fixed 30 second stereo test signal, so runs
+  on different machines stay comparable. Every bounce has to match the
+  one without a pool sample for sample; the exit code is 1 if one doesn't.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr double testSignalSeconds = 30.0;
+    constexpr double testSignalRate = 48000.0;
+
+    // The pool switched off: every task on the calling thread, in order
+    class SerialTaskPool : public RenderTaskPool
+    {
+    public:
+        void forEach(int numTasks, const Task& task) override
+        {
+            for (int i = 0; i < numTasks; ++i)
+                task(i);
+        }
+    };
+
+    // Noise bursts with gaps, so the tail keeps building and decaying
+    juce::AudioBuffer<float> createTestSignal()
+    {
+        const int numSamples = static_cast<int>(testSignalSeconds * testSignalRate);
+        juce::AudioBuffer<float> signal(2, numSamples);
+        juce::Random random(1);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const bool burst = (i / static_cast<int>(testSignalRate / 4)) % 4 == 0;
+
+            for (int channel = 0; channel < 2; ++channel)
+                signal.setSample(channel, i, burst ? random.nextFloat() * 0.5f - 0.25f : 0.0f);
+        }
+
+        return signal;
+    }
+
+    struct Scenario
+    {
+        const char* name;
+        juce::AudioChannelSet output;
+    };
+
+    // Renders input (stereo) to output; returns the wall time in seconds
+    double render(const juce::AudioBuffer<float>& input, double sampleRate, int blockSize,
+                  const Scenario& scenario, RenderTaskPool& pool, juce::AudioBuffer<float>& output)
+    {
+        std::unique_ptr<DdxReverbAudioProcessor> processor(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+
+        auto layout = processor->getBusesLayout();
+
+        for (auto& bus : layout.inputBuses)
+            bus = juce::AudioChannelSet::disabled();
+
+        for (auto& bus : layout.outputBuses)
+            bus = juce::AudioChannelSet::disabled();
+
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::stereo();
+        layout.outputBuses.getReference(0) = scenario.output;
+        processor->setBusesLayout(layout);
+
+        // Some Bass Multiply, so the low band has work to run alongside
+        auto* bassMult = processor->getAPVTS().getParameter("bassmult");
+        bassMult->setValueNotifyingHost(bassMult->convertTo0to1(5.0f));
+
+        processor->setNonRealtime(true);
+        processor->setHostTaskPool(&pool);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        const int numChannels = juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels());
+        const int numSamples = input.getNumSamples();
+
+        output.setSize(numChannels, numSamples);
+        output.clear();
+
+        for (int channel = 0; channel < 2; ++channel)
+            output.copyFrom(channel, 0, input, juce::jmin(channel, input.getNumChannels() - 1), 0, numSamples);
+
+        juce::MidiBuffer midi;
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int offset = 0; offset < numSamples; offset += blockSize)
+        {
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), numChannels, offset,
+                                           juce::jmin(blockSize, numSamples - offset));
+            processor->processBlock(block, midi);
+        }
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        processor->releaseResources();
+        processor->setHostTaskPool(nullptr);
+        return seconds;
+    }
+
+    bool isIdentical(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp(a.getReadPointer(channel), b.getReadPointer(channel), sizeof(float) * static_cast<size_t>(a.getNumSamples())) != 0)
+                return false;
+
+        return true;
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::String inputPath = argc > 1 ? juce::String(argv[1]) : juce::String();
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 512;
+
+    if (blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [input.wav] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    juce::AudioBuffer<float> input;
+    double sampleRate = testSignalRate;
+
+    if (inputPath.isEmpty())
+    {
+        input = createTestSignal();
+    }
+    else
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(juce::File::getCurrentWorkingDirectory().getChildFile(inputPath)));
+
+        if (reader == nullptr)
+        {
+            std::fprintf(stderr, "cannot read %s\n", inputPath.toRawUTF8());
+            return 2;
+        }
+
+        // Read up front, so the timing is the render alone
+        input.setSize(juce::jmax(1, static_cast<int>(reader->numChannels)), static_cast<int>(reader->lengthInSamples));
+        reader->read(&input, 0, input.getNumSamples(), 0, true, true);
+        sampleRate = reader->sampleRate;
+    }
+
+    const double audioSeconds = input.getNumSamples() / sampleRate;
+    const int maxCores = juce::jmin(RenderTaskPool::maxTasks, juce::SystemStats::getNumCpus());
+
+    const Scenario scenarios[] = {
+        { "stereo", juce::AudioChannelSet::stereo() },
+        { "7.1 surround", juce::AudioChannelSet::create7point1() }
+    };
+
+    std::printf("%s, %.1f s at %.0f Hz, %d-sample blocks, %d cpus\n",
+                inputPath.isEmpty() ? "test signal" : inputPath.toRawUTF8(), audioSeconds, sampleRate,
+                blockSize, juce::SystemStats::getNumCpus());
+    std::printf("layout          cores   render s   x realtime   speedup\n");
+
+    bool allIdentical = true;
+
+    for (const auto& scenario : scenarios)
+    {
+        juce::AudioBuffer<float> reference, output;
+
+        SerialTaskPool serial;
+        const double serialSeconds = render(input, sampleRate, blockSize, scenario, serial, reference);
+        std::printf("%-14s  %5s   %8.2f   %10.1f   %7.2fx\n", scenario.name, "off", serialSeconds, audioSeconds / serialSeconds, 1.0);
+
+        for (int cores = 2; cores <= maxCores; ++cores)
+        {
+            OfflineRenderPool pool(cores);
+            const double seconds = render(input, sampleRate, blockSize, scenario, pool, output);
+            const bool identical = isIdentical(reference, output);
+            allIdentical = allIdentical && identical;
+
+            std::printf("%-14s  %5d   %8.2f   %10.1f   %7.2fx%s\n", scenario.name, cores, seconds,
+                        audioSeconds / seconds, serialSeconds / seconds, identical ? "" : "   OUTPUT DIFFERS");
+        }
+    }
+
+    return allIdentical ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Double-Precision Benchmark
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file. A 64-bit host feeding a float-only
+  plugin converts every block to float and back; this times that against
+  the native double processBlock, with and without the engine's double
+  accumulators, and measures what the conversion does to the dry path:
+
+    PrecisionBenchmark [sampleRate]
+
+  The error columns are the worst deviation from the input with the mix at
+  fully dry, where an exact processor returns its input unchanged.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr double secondsPerRun = 4.0;
+    constexpr int warmupBlocks = 64;
+
+    enum class Path { hostConversion, nativeDouble, wideAccumulators };
+
+    std::unique_ptr<DdxReverbAudioProcessor> createProcessor(Path path, double sampleRate, int blockSize, float wet)
+    {
+        std::unique_ptr<DdxReverbAudioProcessor> processor(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+
+        if (path != Path::hostConversion)
+            processor->setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+
+        auto& apvts = processor->getAPVTS();
+        apvts.getParameter("wet")->setValueNotifyingHost(apvts.getParameter("wet")->convertTo0to1(wet));
+        apvts.getParameter("wideaccum")->setValueNotifyingHost(path == Path::wideAccumulators ? 1.0f : 0.0f);
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+        return processor;
+    }
+
+    void fillNoise(juce::AudioBuffer<double>& buffer, juce::Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, random.nextDouble() * 0.5 - 0.25);
+    }
+
+    // One host block: the 64-bit host's buffer in, the processed block back in it
+    void processHostBlock(DdxReverbAudioProcessor& processor, Path path, juce::AudioBuffer<double>& hostBuffer,
+                          juce::AudioBuffer<float>& floatBuffer, juce::MidiBuffer& midi)
+    {
+        if (path == Path::hostConversion)
+        {
+            floatBuffer.makeCopyOf(hostBuffer, true);
+            processor.processBlock(floatBuffer, midi);
+            hostBuffer.makeCopyOf(floatBuffer, true);
+        }
+        else
+        {
+            processor.processBlock(hostBuffer, midi);
+        }
+    }
+
+    // Average microseconds per block, input generation excluded
+    double timeBlocks(Path path, double sampleRate, int blockSize)
+    {
+        auto processor = createProcessor(path, sampleRate, blockSize, 0.5f);
+        juce::AudioBuffer<double> hostBuffer(2, blockSize);
+        juce::AudioBuffer<float> floatBuffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1);
+
+        const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+        double totalMicroseconds = 0.0;
+
+        for (int block = 0; block < warmupBlocks + numBlocks; ++block)
+        {
+            fillNoise(hostBuffer, random);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            processHostBlock(*processor, path, hostBuffer, floatBuffer, midi);
+
+            if (block >= warmupBlocks)
+                totalMicroseconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+        }
+
+        return totalMicroseconds / numBlocks;
+    }
+
+    // Worst dry-path deviation in dB relative to full scale
+    double measureDryError(Path path, double sampleRate, int blockSize)
+    {
+        auto processor = createProcessor(path, sampleRate, blockSize, 0.0f);
+        juce::AudioBuffer<double> hostBuffer(2, blockSize);
+        juce::AudioBuffer<double> input(2, blockSize);
+        juce::AudioBuffer<float> floatBuffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(2);
+        double maxError = 0.0;
+
+        for (int block = 0; block < 200; ++block)
+        {
+            fillNoise(input, random);
+            hostBuffer.makeCopyOf(input, true);
+            processHostBlock(*processor, path, hostBuffer, floatBuffer, midi);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    maxError = juce::jmax(maxError, std::abs(hostBuffer.getSample(channel, i) - input.getSample(channel, i)));
+        }
+
+        return maxError > 0.0 ? juce::Decibels::gainToDecibels(maxError, -400.0) : -std::numeric_limits<double>::infinity();
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+
+    if (sampleRate < 8000.0)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("%.0f Hz, stereo insert, SHARC combs, scalar\n", sampleRate);
+    std::printf("block   convert us   double us   saved %%   wide acc us   wide cost %%\n");
+
+    for (int blockSize : { 32, 64, 128, 256, 512, 1024 })
+    {
+        const double convertMicroseconds = timeBlocks(Path::hostConversion, sampleRate, blockSize);
+        const double doubleMicroseconds = timeBlocks(Path::nativeDouble, sampleRate, blockSize);
+        const double wideMicroseconds = timeBlocks(Path::wideAccumulators, sampleRate, blockSize);
+
+        std::printf("%5d   %10.2f   %9.2f   %7.2f   %11.2f   %11.2f\n",
+                    blockSize, convertMicroseconds, doubleMicroseconds,
+                    100.0 * (convertMicroseconds - doubleMicroseconds) / convertMicroseconds,
+                    wideMicroseconds, 100.0 * (wideMicroseconds - doubleMicroseconds) / doubleMicroseconds);
+    }
+
+    std::printf("\ndry path error at 0%% wet (dBFS): host conversion %.1f, native double %.1f\n",
+                measureDryError(Path::hostConversion, sampleRate, 256),
+                measureDryError(Path::nativeDouble, sampleRate, 256));
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Instantiation / Prepare Benchmark
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file. Times what a host pays to create an
+  instance and to start the transport, and what the same prepareToPlay cost
+  before it learnt to skip redundant work:
+
+    PrepareBenchmark [sampleRate] [blockSize]
+
+  The "before" column is a full engine prepare - resize and zero-fill of
+  every delay line - which the old prepareToPlay ran on every call.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr int numRuns = 50;
+
+    double elapsedMs(juce::int64 start)
+    {
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1000.0;
+    }
+
+    std::unique_ptr<DdxReverbAudioProcessor> createProcessor()
+    {
+        return std::unique_ptr<DdxReverbAudioProcessor>(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+    }
+
+    // What the old prepareToPlay did to the network on every call
+    double timeEnginePrepare(double sampleRate, int blockSize)
+    {
+        DdxReverbEngine engine;
+        double totalMs = 0.0;
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            engine.prepare({ sampleRate, blockSize });
+            totalMs += elapsedMs(start);
+        }
+
+        return totalMs / numRuns;
+    }
+
+    void printRow(const char* name, double beforeMs, double afterMs)
+    {
+        std::printf("%-26s  %9.3f  %9.3f  %9.1fx\n", name, beforeMs, afterMs, afterMs > 0.0 ? beforeMs / afterMs : 0.0);
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    // The lower rate fits the memory sized for the higher one
+    const double lowerRate = sampleRate == 48000.0 ? 44100.0 : sampleRate * 0.5;
+
+    double constructionMs = 0.0, firstPrepareMs = 0.0, repeatPrepareMs = 0.0, rateChangeMs = 0.0;
+
+    for (int run = 0; run < numRuns; ++run)
+    {
+        auto processor = createProcessor();
+        constructionMs += processor->getConstructionTimeMs();
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+        firstPrepareMs += processor->getLastPrepareTimeMs();
+
+        // Transport start: same settings again
+        processor->releaseResources();
+        processor->prepareToPlay(sampleRate, blockSize);
+        repeatPrepareMs += processor->getLastPrepareTimeMs();
+
+        // Session switched to a lower rate
+        processor->releaseResources();
+        processor->setRateAndBufferSizeDetails(lowerRate, blockSize);
+        processor->prepareToPlay(lowerRate, blockSize);
+        rateChangeMs += processor->getLastPrepareTimeMs();
+    }
+
+    const double enginePrepareMs = timeEnginePrepare(sampleRate, blockSize);
+    const double engineLowerPrepareMs = timeEnginePrepare(lowerRate, blockSize);
+
+    std::printf("%.0f Hz, %d-sample blocks, average of %d instances\n", sampleRate, blockSize, numRuns);
+    std::printf("instantiation %.3f ms, first prepare %.3f ms\n\n", constructionMs / numRuns, firstPrepareMs / numRuns);
+    std::printf("prepareToPlay               before ms   after ms    speedup\n");
+    printRow("transport start (same)", enginePrepareMs, repeatPrepareMs / numRuns);
+    printRow("rate change (fits memory)", engineLowerPrepareMs, rateChangeMs / numRuns);
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Out-of-Process Engine Host (Linux)
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file; install it as DDX3216EngineHost next
+  to the plugin binary.
+
+    DDX3216EngineHost --engine <segment>   run one engine for a plugin instance
+    DDX3216EngineHost --benchmark          round-trip overhead at 32-512 samples
+
+  Engine mode maps the segment the plugin created and runs the same
+  DdxReverbAudioProcessor on each slot in place, on a realtime thread,
+  with the main thread running the processor's message loop. It exits
+  when the plugin asks it to or when the plugin's process is gone.
+
+  Benchmark mode times processBlock for an in-process instance and for one
+  in out-of-process mode (which launches this binary as its engine), and
+  reports the difference per block.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../SharedAudioRing.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+
+namespace
+{
+    std::unique_ptr<DdxReverbAudioProcessor> createProcessor()
+    {
+        return std::unique_ptr<DdxReverbAudioProcessor>(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+    }
+
+    //==============================================================================
+    // Engine mode
+    //==============================================================================
+    class EngineThread : public juce::Thread
+    {
+    public:
+        EngineThread(SharedAudioRing& r, DdxReverbAudioProcessor& p)
+            : juce::Thread("DDX3216 Engine"), ring(r), processor(p)
+        {
+        }
+
+        void run() override
+        {
+            auto& header = ring.getHeader();
+            juce::MidiBuffer midi;
+            juce::uint32 completed = 0;
+
+            ring.setEngineState(SharedAudioRing::ready);
+
+            while (header.engineState.load() != SharedAudioRing::shutdown && isClientAlive(header.clientProcessId))
+            {
+                const auto submitted = ring.waitForWork(completed, idleWaitMicroseconds);
+
+                while (completed != submitted)
+                {
+                    auto& slot = ring.getSlot(completed);
+                    const auto start = juce::Time::getHighResolutionTicks();
+
+                    processor.setParameterValues(slot.parameters, header.numParameters);
+
+                    // The slot's own channels - processed in place, no copies
+                    float* channels[SharedAudioRing::numChannels];
+
+                    for (int channel = 0; channel < SharedAudioRing::numChannels; ++channel)
+                        channels[channel] = ring.getSlotChannel(completed, channel);
+
+                    juce::AudioBuffer<float> block(channels, SharedAudioRing::numChannels, slot.numSamples);
+                    processor.processBlock(block, midi);
+
+                    slot.engineMicroseconds = static_cast<float>(
+                        juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6);
+
+                    ring.complete();
+                    ++completed;
+                }
+            }
+
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+        }
+
+    private:
+        static bool isClientAlive(int processId) noexcept
+        {
+            return ::kill(static_cast<pid_t>(processId), 0) == 0 || errno == EPERM;
+        }
+
+        static constexpr double idleWaitMicroseconds = 100000.0;
+
+        SharedAudioRing& ring;
+        DdxReverbAudioProcessor& processor;
+    };
+
+    int runEngine(const juce::String& segmentName)
+    {
+        SharedAudioRing ring;
+
+        if (!ring.open(segmentName))
+            return 1;
+
+        const auto& header = ring.getHeader();
+        auto processor = createProcessor();
+        processor->markAsEngineProcess();
+
+        // Both ends must agree on the parameter list
+        if (header.numParameters != processor->getNumStateParameters())
+            return 1;
+
+        processor->setRateAndBufferSizeDetails(header.sampleRate, header.maxBlockSize);
+        processor->prepareToPlay(header.sampleRate, header.maxBlockSize);
+
+        EngineThread engine(ring, *processor);
+
+        const auto options = juce::Thread::RealtimeOptions {}
+                                 .withPriority(10)
+                                 .withApproximateAudioProcessingTime(header.maxBlockSize, header.sampleRate);
+
+        if (!engine.startRealtimeThread(options))
+            engine.startThread(juce::Thread::Priority::highest);
+
+        // This is the processor's message thread: an internal-rate toggle
+        // rebuilds the engine through handleAsyncUpdate here, as in the plugin.
+        // The engine thread ends the loop when it stops.
+        juce::MessageManager::getInstance()->runDispatchLoop();
+        engine.stopThread(1000);
+
+        processor->releaseResources();
+        return 0;
+    }
+
+    //==============================================================================
+    // Benchmark mode
+    //==============================================================================
+    double timeBlocks(DdxReverbAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int numBlocks)
+    {
+        juce::MidiBuffer midi;
+        juce::Random random(1);
+        double totalMicroseconds = 0.0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            totalMicroseconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+        }
+
+        return totalMicroseconds / numBlocks;
+    }
+
+    int runBenchmark(const juce::File& self)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr double secondsPerRun = 4.0;
+        constexpr int warmupBlocks = 64;
+
+        // The out-of-process instance launches this binary as its engine
+        ::setenv("DDX3216_ENGINE_HOST", self.getFullPathName().toRawUTF8(), 1);
+
+        std::printf("block   period us   local us   remote us   overhead us   overhead %%   transport us\n");
+
+        for (int blockSize : { 32, 64, 128, 256, 512 })
+        {
+            auto local = createProcessor();
+            auto remote = createProcessor();
+            remote->getAPVTS().getParameter("outofprocess")->setValueNotifyingHost(1.0f);
+            remote->setTelemetryEnabled(true);
+
+            for (auto* processor : { local.get(), remote.get() })
+            {
+                processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+                processor->prepareToPlay(sampleRate, blockSize);
+            }
+
+            if (!remote->isRemoteEngineActive())
+            {
+                std::fprintf(stderr, "engine process did not start at %d samples\n", blockSize);
+                return 1;
+            }
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+
+            timeBlocks(*local, buffer, warmupBlocks);
+            timeBlocks(*remote, buffer, warmupBlocks);
+
+            const double localMicroseconds = timeBlocks(*local, buffer, numBlocks);
+            const double remoteMicroseconds = timeBlocks(*remote, buffer, numBlocks);
+            const double periodMicroseconds = 1.0e6 * blockSize / sampleRate;
+            const double overhead = remoteMicroseconds - localMicroseconds;
+
+            if (!remote->isRemoteEngineActive())
+                std::fprintf(stderr, "engine missed a deadline at %d samples - remote figures include in-process blocks\n", blockSize);
+
+            std::printf("%5d   %9.1f   %8.1f   %9.1f   %11.1f   %10.2f   %12.1f\n",
+                        blockSize, periodMicroseconds, localMicroseconds, remoteMicroseconds,
+                        overhead, 100.0 * overhead / periodMicroseconds,
+                        remote->readTelemetry().remoteOverheadMicroseconds);
+        }
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::StringArray args(argv + 1, argc - 1);
+
+    if (args.size() == 2 && args[0] == "--engine")
+        return runEngine(args[1]);
+
+    if (args.size() == 1 && args[0] == "--benchmark")
+        return runBenchmark(juce::File::getSpecialLocation(juce::File::currentExecutableFile));
+
+    std::fprintf(stderr, "usage: %s --engine <segment> | --benchmark\n", argv[0]);
+    return 2;
+}
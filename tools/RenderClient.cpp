@@ -0,0 +1,196 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Render Client (Linux)
+
+  Command-line client for the render daemon, for testing and scripting.
+  Plain C++17, no JUCE:
+
+    c++ -std=c++17 -O2 tools/RenderClient.cpp -o ddx3216-render
+
+    ddx3216-render [--socket path] input.wav output.wav [paramID=value ...]
+    ddx3216-render [--socket path] --jobs jobs.txt
+    ddx3216-render [--socket path] --stats
+
+  A jobs file has one render per line: input, output and any parameters,
+  separated by tabs. Every reply from the daemon is printed as it arrives,
+  followed by a summary and the daemon's STATS line.
+*/
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int connectTo(const std::string& path)
+    {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+
+        if (path.size() >= sizeof(address.sun_path))
+            return -1;
+
+        std::strcpy(address.sun_path, path.c_str());
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    bool sendAll(int fd, const std::string& text)
+    {
+        size_t sent = 0;
+
+        while (sent < text.size())
+        {
+            const auto written = ::send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+
+            if (written <= 0)
+                return false;
+
+            sent += static_cast<size_t>(written);
+        }
+
+        return true;
+    }
+
+    // Prints every reply line until the daemon closes its side; counts results
+    void readReplies(int fd, int& done, int& failed)
+    {
+        std::string pending;
+        char data[4096];
+
+        for (;;)
+        {
+            const auto received = ::recv(fd, data, sizeof(data), 0);
+
+            if (received <= 0)
+                break;
+
+            pending.append(data, static_cast<size_t>(received));
+
+            for (auto newline = pending.find('\n'); newline != std::string::npos; newline = pending.find('\n'))
+            {
+                const auto line = pending.substr(0, newline);
+                pending.erase(0, newline + 1);
+
+                if (line.rfind("DONE", 0) == 0)
+                    ++done;
+                else if (line.rfind("ERROR", 0) == 0)
+                    ++failed;
+
+                std::printf("%s\n", line.c_str());
+            }
+        }
+    }
+
+    void printUsage(const char* name)
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--socket path] input output [paramID=value ...]\n"
+                     "       %s [--socket path] --jobs file\n"
+                     "       %s [--socket path] --stats\n", name, name, name);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string socketPath = "/tmp/ddx3216-render.sock";
+
+    if (args.size() >= 2 && args[0] == "--socket")
+    {
+        socketPath = args[1];
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    if (args.empty())
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> requests;
+
+    if (args[0] == "--stats")
+    {
+        requests.push_back("STATS");
+    }
+    else if (args[0] == "--jobs" && args.size() == 2)
+    {
+        std::ifstream jobs(args[1]);
+        std::string line;
+
+        while (std::getline(jobs, line))
+            if (!line.empty() && line[0] != '#')
+                requests.push_back("RENDER\t" + line);
+    }
+    else if (args.size() >= 2)
+    {
+        std::string request = "RENDER\t" + args[0] + "\t" + args[1];
+
+        for (size_t i = 2; i < args.size(); ++i)
+            request += "\t" + args[i];
+
+        requests.push_back(request);
+    }
+    else
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    const int fd = connectTo(socketPath);
+
+    if (fd < 0)
+    {
+        std::fprintf(stderr, "cannot connect to %s - is the daemon running?\n", socketPath.c_str());
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto& request : requests)
+        if (!sendAll(fd, request + "\n"))
+            return 1;
+
+    // Tells the daemon we're done submitting; it closes once every job is answered
+    ::shutdown(fd, SHUT_WR);
+
+    int done = 0, failed = 0;
+    readReplies(fd, done, failed);
+    ::close(fd);
+
+    if (args[0] == "--stats")
+        return 0;
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%d rendered, %d failed in %.1f s\n", done, failed, seconds);
+
+    // Daemon-wide throughput
+    const int statsFd = connectTo(socketPath);
+
+    if (statsFd >= 0 && sendAll(statsFd, "STATS\n"))
+    {
+        ::shutdown(statsFd, SHUT_WR);
+        int unused = 0;
+        readReplies(statsFd, unused, unused);
+    }
+
+    if (statsFd >= 0)
+        ::close(statsFd);
+
+    return failed == 0 ? 0 : 1;
+}
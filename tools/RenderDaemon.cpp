@@ -0,0 +1,464 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Render Daemon (Linux)
+  JUCE 8.0.11
+
+  Headless batch renderer for stems. Console app built from the plugin
+  sources plus this file; it runs one DdxReverbAudioProcessor per stream
+  and schedules the streams' chunks across cores on a WorkStealingPool.
+
+    DDX3216RenderDaemon [--socket /tmp/ddx3216-render.sock] [--threads N]
+
+  Protocol: one request per line on a local Unix socket, fields separated
+  by tabs (so paths may contain spaces):
+
+    RENDER <tab> input <tab> output [<tab> paramID=value ...]
+    STATS
+
+  Parameter values are in the parameter's own units (decay=8.5, wet=1).
+  Each RENDER gets one reply line when it finishes:
+
+    DONE <tab> id <tab> output <tab> audio s <tab> cpu s <tab> x realtime per core
+    ERROR <tab> id <tab> message
+
+  STATS replies straight away with the daemon's totals: realtime multiple
+  per core (audio seconds / worker busy seconds) and overall (audio seconds
+  / wall time since the first job).
+
+  A connection stays open until the client has shut down its sending side
+  and every job it submitted has been answered. Outputs are 24-bit stereo
+  WAV at the input's rate, including the reverb tail.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../WorkStealingPool.h"
+
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int blockSize = 512;
+    constexpr int chunkSize = 64 * blockSize; // one scheduling unit, ~0.7 s at 48 kHz
+
+    std::atomic<bool> shouldQuit { false };
+    int listenSocket = -1;
+
+    //==============================================================================
+    // Daemon-wide figures for STATS
+    //==============================================================================
+    struct Totals
+    {
+        std::atomic<int> jobsDone { 0 };
+        std::atomic<int> jobsFailed { 0 };
+        std::atomic<double> audioSeconds { 0.0 };
+        std::atomic<double> firstJobTime { 0.0 }; // ms, 0 until the first job arrives
+
+        // Several workers finish chunks at once
+        void addAudio(double seconds) noexcept
+        {
+            auto current = audioSeconds.load();
+
+            while (!audioSeconds.compare_exchange_weak(current, current + seconds))
+            {
+            }
+        }
+
+        void markJobQueued() noexcept
+        {
+            double none = 0.0;
+            firstJobTime.compare_exchange_strong(none, juce::Time::getMillisecondCounterHiRes());
+        }
+    };
+
+    //==============================================================================
+    // Runs a processor's forks in order on its own worker: the streams are
+    // what is spread over the cores
+    //==============================================================================
+    class SerialTaskPool : public RenderTaskPool
+    {
+    public:
+        void forEach(int numTasks, const Task& task) override
+        {
+            for (int i = 0; i < numTasks; ++i)
+                task(i);
+        }
+    };
+
+    SerialTaskPool serialTaskPool;
+
+    //==============================================================================
+    // One client connection. Replies can come from any worker.
+    //==============================================================================
+    class Connection
+    {
+    public:
+        explicit Connection(int socketFd) : fd(socketFd) {}
+
+        ~Connection()
+        {
+            ::close(fd);
+        }
+
+        void send(const juce::String& line)
+        {
+            const std::lock_guard<std::mutex> lock(sendLock);
+            const auto text = line + "\n";
+            const char* data = text.toRawUTF8();
+            size_t remaining = std::strlen(data);
+
+            while (remaining > 0)
+            {
+                const auto written = ::send(fd, data, remaining, MSG_NOSIGNAL);
+
+                if (written <= 0)
+                    return;
+
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+        }
+
+        int getSocket() const noexcept { return fd; }
+
+        // The last reply closes the connection (once the client is done sending)
+        std::atomic<int> pendingJobs { 0 };
+
+    private:
+        const int fd;
+        std::mutex sendLock;
+    };
+
+    //==============================================================================
+    // One stream: reader -> processor -> writer, a chunk per task
+    //==============================================================================
+    class RenderJob
+    {
+    public:
+        RenderJob(int jobId, juce::File in, juce::File out, juce::StringPairArray params,
+                  std::shared_ptr<Connection> conn, Totals& t)
+            : id(jobId), inputFile(std::move(in)), outputFile(std::move(out)),
+              parameters(std::move(params)), connection(std::move(conn)), totals(t)
+        {
+        }
+
+        // Worker thread. Re-submits itself until the stream is finished, so
+        // other workers can pick up other streams (or steal this one) between chunks.
+        static void runChunk(std::shared_ptr<RenderJob> job, WorkStealingPool& pool)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            juce::String error;
+            bool finished = false;
+
+            if (job->processor == nullptr && !job->open(error))
+                finished = true;
+            else
+                finished = job->renderChunk(error);
+
+            job->cpuSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            if (finished)
+                job->finish(error);
+            else
+                pool.submit([job, &pool] { runChunk(job, pool); });
+        }
+
+    private:
+        bool open(juce::String& error)
+        {
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+
+            reader.reset(formats.createReaderFor(inputFile));
+
+            if (reader == nullptr)
+            {
+                error = "cannot read " + inputFile.getFullPathName();
+                return false;
+            }
+
+            outputFile.deleteFile();
+            auto stream = outputFile.createOutputStream();
+
+            if (stream == nullptr)
+            {
+                error = "cannot write " + outputFile.getFullPathName();
+                return false;
+            }
+
+            juce::WavAudioFormat wav;
+            writer.reset(wav.createWriterFor(stream.get(), reader->sampleRate, 2, 24, {}, 0));
+
+            if (writer == nullptr)
+            {
+                error = "cannot create WAV writer";
+                return false;
+            }
+
+            stream.release(); // owned by the writer now
+
+            processor.reset(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+
+            auto& apvts = processor->getAPVTS();
+
+            for (auto& key : parameters.getAllKeys())
+            {
+                auto* param = apvts.getParameter(key);
+
+                if (param == nullptr)
+                {
+                    error = "unknown parameter " + key;
+                    return false;
+                }
+
+                param->setValueNotifyingHost(param->convertTo0to1(parameters[key].getFloatValue()));
+            }
+
+            // A bounce, with the same rendering however busy the daemon is
+            processor->setHostTaskPool(&serialTaskPool);
+            processor->setNonRealtime(true);
+            processor->setRateAndBufferSizeDetails(reader->sampleRate, blockSize);
+            processor->prepareToPlay(reader->sampleRate, blockSize);
+
+            // Input plus the tail the processor reports for these settings
+            inputLength = reader->lengthInSamples;
+            totalLength = inputLength + static_cast<juce::int64>(processor->getTailLengthSeconds() * reader->sampleRate);
+
+            chunk.setSize(2, chunkSize);
+            return true;
+        }
+
+        // True once the stream (or an error) is complete
+        bool renderChunk(juce::String& error)
+        {
+            const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(chunkSize), totalLength - position));
+
+            // Past the end of the input the reader fills with silence
+            if (!reader->read(&chunk, 0, numSamples, position, true, true))
+            {
+                error = "read failed";
+                return true;
+            }
+
+            // A mono input is read into both channels by the reader
+            for (int offset = 0; offset < numSamples; offset += blockSize)
+            {
+                const int numBlockSamples = juce::jmin(blockSize, numSamples - offset);
+                juce::AudioBuffer<float> block(chunk.getArrayOfWritePointers(), 2, offset, numBlockSamples);
+                processor->processBlock(block, midi);
+            }
+
+            if (!writer->writeFromAudioSampleBuffer(chunk, 0, numSamples))
+            {
+                error = "write failed";
+                return true;
+            }
+
+            position += numSamples;
+
+            // The tail ends early once the network has gone to sleep
+            return position >= totalLength || (position >= inputLength && processor->isNetworkAsleep());
+        }
+
+        void finish(const juce::String& error)
+        {
+            const double audioSeconds = reader != nullptr ? static_cast<double>(position) / reader->sampleRate : 0.0;
+
+            // Flush and close before the client is told it's done
+            writer.reset();
+
+            if (processor != nullptr)
+                processor->releaseResources();
+
+            processor.reset();
+            reader.reset();
+
+            if (error.isNotEmpty())
+            {
+                ++totals.jobsFailed;
+                connection->send("ERROR\t" + juce::String(id) + "\t" + error);
+            }
+            else
+            {
+                ++totals.jobsDone;
+                totals.addAudio(audioSeconds);
+
+                connection->send("DONE\t" + juce::String(id) + "\t" + outputFile.getFullPathName()
+                                 + "\t" + juce::String(audioSeconds, 2) + "\t" + juce::String(cpuSeconds, 3)
+                                 + "\t" + juce::String(audioSeconds / juce::jmax(1.0e-9, cpuSeconds), 1));
+            }
+
+            if (--connection->pendingJobs == 0)
+                ::shutdown(connection->getSocket(), SHUT_WR);
+        }
+
+        const int id;
+        const juce::File inputFile;
+        juce::File outputFile;
+        const juce::StringPairArray parameters;
+        std::shared_ptr<Connection> connection;
+        Totals& totals;
+
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        std::unique_ptr<DdxReverbAudioProcessor> processor;
+        juce::AudioBuffer<float> chunk;
+        juce::MidiBuffer midi;
+
+        juce::int64 inputLength = 0;
+        juce::int64 totalLength = 0;
+        juce::int64 position = 0;
+        double cpuSeconds = 0.0; // only ever touched by the worker running the chunk
+    };
+
+    //==============================================================================
+    // Reads request lines from one client and queues its jobs
+    //==============================================================================
+    void serveConnection(std::shared_ptr<Connection> connection, WorkStealingPool& pool, Totals& totals)
+    {
+        static std::atomic<int> nextJobId { 1 };
+
+        // Held until the client stops sending, so early replies can't close us
+        ++connection->pendingJobs;
+
+        juce::String pending;
+        char data[4096];
+
+        for (;;)
+        {
+            const auto received = ::recv(connection->getSocket(), data, sizeof(data), 0);
+
+            if (received <= 0)
+                break;
+
+            pending += juce::String::fromUTF8(data, static_cast<int>(received));
+
+            for (int newline = pending.indexOfChar('\n'); newline >= 0; newline = pending.indexOfChar('\n'))
+            {
+                const auto line = pending.substring(0, newline).trimCharactersAtEnd("\r");
+                pending = pending.substring(newline + 1);
+
+                auto fields = juce::StringArray::fromTokens(line, "\t", {});
+
+                if (fields.isEmpty() || fields[0].isEmpty())
+                    continue;
+
+                if (fields[0] == "STATS")
+                {
+                    const double firstJob = totals.firstJobTime.load();
+                    const double wallSeconds = firstJob > 0.0 ? (juce::Time::getMillisecondCounterHiRes() - firstJob) / 1000.0 : 0.0;
+                    const double audioSeconds = totals.audioSeconds.load();
+                    const double busySeconds = pool.getBusySeconds();
+
+                    connection->send("STATS\tjobs=" + juce::String(totals.jobsDone.load())
+                                     + "\tfailed=" + juce::String(totals.jobsFailed.load())
+                                     + "\tworkers=" + juce::String(pool.getNumWorkers())
+                                     + "\taudio=" + juce::String(audioSeconds, 1)
+                                     + "\tbusy=" + juce::String(busySeconds, 1)
+                                     + "\tsteals=" + juce::String(pool.getNumSteals())
+                                     + "\trt_per_core=" + juce::String(audioSeconds / juce::jmax(1.0e-9, busySeconds), 1)
+                                     + "\trt_total=" + juce::String(audioSeconds / juce::jmax(1.0e-9, wallSeconds), 1));
+                    continue;
+                }
+
+                if (fields[0] != "RENDER" || fields.size() < 3)
+                {
+                    connection->send("ERROR\t0\tbad request: " + line);
+                    continue;
+                }
+
+                juce::StringPairArray params;
+
+                for (int i = 3; i < fields.size(); ++i)
+                    params.set(fields[i].upToFirstOccurrenceOf("=", false, false).trim(),
+                               fields[i].fromFirstOccurrenceOf("=", false, false).trim());
+
+                const int id = nextJobId++;
+                ++connection->pendingJobs;
+                totals.markJobQueued();
+
+                auto job = std::make_shared<RenderJob>(id, juce::File(fields[1]), juce::File(fields[2]),
+                                                       params, connection, totals);
+                connection->send("QUEUED\t" + juce::String(id));
+                pool.submit([job, &pool] { RenderJob::runChunk(job, pool); });
+            }
+        }
+
+        if (--connection->pendingJobs == 0)
+            ::shutdown(connection->getSocket(), SHUT_WR);
+    }
+
+    void handleSignal(int)
+    {
+        shouldQuit = true;
+
+        if (listenSocket >= 0)
+            ::shutdown(listenSocket, SHUT_RDWR);
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::StringArray args(argv + 1, argc - 1);
+    juce::String socketPath = "/tmp/ddx3216-render.sock";
+    int numThreads = juce::SystemStats::getNumCpus();
+
+    for (int i = 0; i + 1 < args.size(); i += 2)
+    {
+        if (args[i] == "--socket")
+            socketPath = args[i + 1];
+        else if (args[i] == "--threads")
+            numThreads = juce::jmax(1, args[i + 1].getIntValue());
+    }
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+    {
+        std::fprintf(stderr, "socket path too long\n");
+        return 1;
+    }
+
+    std::strcpy(address.sun_path, socketPath.toRawUTF8());
+    ::unlink(address.sun_path);
+
+    listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (listenSocket < 0
+        || ::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listenSocket, 16) != 0)
+    {
+        std::fprintf(stderr, "cannot listen on %s\n", address.sun_path);
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    Totals totals;
+    WorkStealingPool pool(numThreads);
+
+    std::printf("DDX3216 render daemon: %s, %d workers\n", address.sun_path, pool.getNumWorkers());
+    std::fflush(stdout);
+
+    while (!shouldQuit)
+    {
+        const int client = ::accept(listenSocket, nullptr, nullptr);
+
+        if (client < 0)
+            continue;
+
+        auto connection = std::make_shared<Connection>(client);
+        std::thread([connection, &pool, &totals] { serveConnection(connection, pool, totals); }).detach();
+    }
+
+    ::close(listenSocket);
+    ::unlink(address.sun_path);
+    return 0;
+}
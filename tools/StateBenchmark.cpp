@@ -0,0 +1,130 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - State Save/Load Benchmark
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file. Opening a session saves or restores
+  every instance in turn; this times one instance's save and load with the
+  binary state and with the XML it replaced, averaged over a session's
+  worth of instances:
+
+    StateBenchmark [numInstances]
+
+  The XML columns are what getStateInformation/setStateInformation did
+  before the binary format; loading XML is still the path old sessions take.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr int roundsPerInstance = 20;
+
+    // Every parameter moved off its default, as in a real session
+    void randomiseParameters(DdxReverbAudioProcessor& processor, juce::Random& random)
+    {
+        for (auto* param : processor.getParameters())
+            param->setValueNotifyingHost(random.nextFloat());
+    }
+
+    // Average microseconds per call over every instance and round
+    template <typename Operation>
+    double timeMicroseconds(std::vector<std::unique_ptr<DdxReverbAudioProcessor>>& instances, Operation&& operation)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int round = 0; round < roundsPerInstance; ++round)
+            for (auto& instance : instances)
+                operation(*instance);
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e6 / (static_cast<double>(roundsPerInstance) * static_cast<double>(instances.size()));
+    }
+
+    void saveXml(DdxReverbAudioProcessor& processor, juce::MemoryBlock& destData)
+    {
+        auto state = processor.getAPVTS().copyState();
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const int numInstances = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    if (numInstances < 1)
+    {
+        std::fprintf(stderr, "usage: %s [numInstances]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::unique_ptr<DdxReverbAudioProcessor>> instances;
+    juce::Random random(1);
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        instances.emplace_back(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+        randomiseParameters(*instances.back(), random);
+    }
+
+    // One saved state per instance, in each format
+    std::vector<juce::MemoryBlock> binaryStates(instances.size());
+    std::vector<juce::MemoryBlock> xmlStates(instances.size());
+
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        instances[i]->getStateInformation(binaryStates[i]);
+        saveXml(*instances[i], xmlStates[i]);
+    }
+
+    // Restores go to the next instance's state, so every load changes values
+    size_t next = 0;
+    const auto nextState = [&](const std::vector<juce::MemoryBlock>& states) -> const juce::MemoryBlock&
+    {
+        next = (next + 1) % states.size();
+        return states[next];
+    };
+
+    juce::MemoryBlock scratch;
+
+    const double binarySave = timeMicroseconds(instances, [&](DdxReverbAudioProcessor& p) { p.getStateInformation(scratch); });
+    const double xmlSave = timeMicroseconds(instances, [&](DdxReverbAudioProcessor& p) { saveXml(p, scratch); });
+
+    const double binaryLoad = timeMicroseconds(instances, [&](DdxReverbAudioProcessor& p)
+    {
+        const auto& state = nextState(binaryStates);
+        p.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    });
+
+    const double xmlLoad = timeMicroseconds(instances, [&](DdxReverbAudioProcessor& p)
+    {
+        const auto& state = nextState(xmlStates);
+        p.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    });
+
+    // A binary round trip has to give back exactly what was saved
+    juce::MemoryBlock before, after;
+    instances[0]->getStateInformation(before);
+    instances[0]->setStateInformation(before.getData(), static_cast<int>(before.getSize()));
+    instances[0]->getStateInformation(after);
+
+    std::printf("%d instances, %d parameters\n", numInstances, instances[0]->getNumStateParameters());
+    std::printf("format   bytes   save us   load us   session save ms   session load ms\n");
+    std::printf("binary   %5d   %7.2f   %7.2f   %15.2f   %15.2f\n", static_cast<int>(binaryStates[0].getSize()),
+                binarySave, binaryLoad, binarySave * numInstances / 1000.0, binaryLoad * numInstances / 1000.0);
+    std::printf("xml      %5d   %7.2f   %7.2f   %15.2f   %15.2f\n", static_cast<int>(xmlStates[0].getSize()),
+                xmlSave, xmlLoad, xmlSave * numInstances / 1000.0, xmlLoad * numInstances / 1000.0);
+
+    if (before != after)
+    {
+        std::printf("\nbinary round trip changed the state\n");
+        return 1;
+    }
+
+    return 0;
+}
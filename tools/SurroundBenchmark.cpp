@@ -0,0 +1,141 @@
+/*
+  DDX3216 Cathedral Reverb Plugin - Surround Layout Benchmark
+  JUCE 8.0.11
+
+  Console app built from the plugin sources (PluginProcessor, PluginEditor
+  and the DSP headers) plus this file. Runs the processor with each output
+  layout it accepts and prints the cost per sample:
+
+    SurroundBenchmark [sampleRate] [blockSize]
+
+  Surround gives every output channel its own decorrelated tail, packed
+  side by side in SIMD lanes, so eight tails should cost little more than
+  the single mono network on a stereo output. Every layout has to stay
+  under three times that; the exit code is 1 if any layout goes over, so
+  the check can run in CI. True stereo is printed alongside for scale.
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr double secondsPerRun = 10.0;
+
+    // Most a layout may cost, relative to the mono network
+    constexpr double budgetRatio = 3.0;
+
+    template <typename ProcessFn>
+    double timeNanosecondsPerSample(int blockSize, double sampleRate, ProcessFn&& process)
+    {
+        const int numBlocks = static_cast<int>(secondsPerRun * sampleRate / blockSize);
+
+        // Warm up caches and let the tail build
+        for (int block = 0; block < numBlocks / 10; ++block)
+            process();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+    }
+
+    // Stereo in, the given main output, every send and quad bus off
+    double timeLayout(const juce::AudioChannelSet& output, bool trueStereo,
+                      double sampleRate, int blockSize, const std::vector<float>& noise)
+    {
+        std::unique_ptr<DdxReverbAudioProcessor> processor(static_cast<DdxReverbAudioProcessor*>(createPluginFilter()));
+
+        auto layout = processor->getBusesLayout();
+
+        for (auto& bus : layout.inputBuses)
+            bus = juce::AudioChannelSet::disabled();
+
+        for (auto& bus : layout.outputBuses)
+            bus = juce::AudioChannelSet::disabled();
+
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::stereo();
+        layout.outputBuses.getReference(0) = output;
+
+        if (!processor->setBusesLayout(layout))
+            return 0.0;
+
+        processor->getAPVTS().getParameter("stereomode")->setValueNotifyingHost(trueStereo ? 1.0f : 0.0f);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(juce::jmax(processor->getTotalNumInputChannels(),
+                                                   processor->getTotalNumOutputChannels()), blockSize);
+        juce::MidiBuffer midi;
+
+        const double ns = timeNanosecondsPerSample(blockSize, sampleRate, [&]
+        {
+            buffer.clear();
+            buffer.copyFrom(0, 0, noise.data(), blockSize);
+            buffer.copyFrom(1, 0, noise.data(), blockSize);
+            processor->processBlock(buffer, midi);
+        });
+
+        processor->releaseResources();
+        return ns;
+    }
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+    {
+        std::fprintf(stderr, "usage: %s [sampleRate] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    juce::Random random(1);
+    std::vector<float> noise(static_cast<size_t>(blockSize));
+
+    for (auto& sample : noise)
+        sample = random.nextFloat() * 0.5f - 0.25f;
+
+    struct Layout
+    {
+        const char* name;
+        juce::AudioChannelSet set;
+    };
+
+    const Layout surroundLayouts[] = {
+        { "5.0", juce::AudioChannelSet::create5point0() },
+        { "5.1", juce::AudioChannelSet::create5point1() },
+        { "7.0", juce::AudioChannelSet::create7point0() },
+        { "7.1", juce::AudioChannelSet::create7point1() }
+    };
+
+    const double monoNs = timeLayout(juce::AudioChannelSet::stereo(), false, sampleRate, blockSize, noise);
+    const double stereoNs = timeLayout(juce::AudioChannelSet::stereo(), true, sampleRate, blockSize, noise);
+
+    std::printf("%.0f Hz, %d-sample blocks, budget under %.0fx the mono network\n", sampleRate, blockSize, budgetRatio);
+    std::printf("layout                 channels     ns/smp   vs mono\n");
+    std::printf("stereo (mono network)  %8d   %8.2f   %6.2fx\n", 2, monoNs, 1.0);
+    std::printf("stereo (true stereo)   %8d   %8.2f   %6.2fx\n", 2, stereoNs, stereoNs / monoNs);
+
+    bool withinBudget = true;
+
+    for (const auto& layout : surroundLayouts)
+    {
+        const double ns = timeLayout(layout.set, false, sampleRate, blockSize, noise);
+        const bool over = ns <= 0.0 || ns / monoNs >= budgetRatio;
+        withinBudget = withinBudget && !over;
+
+        std::printf("%-21s  %8d   %8.2f   %6.2fx%s\n", layout.name, layout.set.size(), ns, ns / monoNs,
+                    ns <= 0.0 ? "   NOT ACCEPTED" : over ? "   OVER BUDGET" : "");
+    }
+
+    return withinBudget ? 0 : 1;
+}